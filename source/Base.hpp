@@ -12,8 +12,8 @@ const std::string CompilationDateAndTime{
 const std::string Separator{
     "=================================================="};
 
+/// \brief Source of seeds for the random engines. Only use this from the main
+/// thread.
 std::random_device RandomDevice;
 
-std::default_random_engine RandomEngine(RandomDevice());
-
 }  // namespace TI4Cartographer
@@ -0,0 +1,309 @@
+#include "Board.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Performance measurements of the generation of one board for one
+/// combination of search engine, seed, board layout, game version, and
+/// aggression.
+struct BenchmarkCase {
+  Search search;
+
+  uint64_t seed{1};
+
+  Layout layout;
+
+  GameVersion game_version;
+
+  Aggression aggression;
+
+  uint64_t number_of_iterations{0};
+
+  uint64_t number_of_valid_boards{0};
+
+  double seconds{0.0};
+
+  float score_imbalance_ratio{0.0f};
+
+  std::string key() const noexcept {
+    return label(search) + "," + std::to_string(seed) + "," + label(layout) + ","
+           + label(game_version) + "," + label(aggression);
+  }
+
+  double valid_board_fraction() const noexcept {
+    if (number_of_iterations == 0) {
+      return 0.0;
+    }
+    return static_cast<double>(number_of_valid_boards)
+           / static_cast<double>(number_of_iterations);
+  }
+
+  double iterations_per_second() const noexcept {
+    if (seconds <= 0.0) {
+      return 0.0;
+    }
+    return static_cast<double>(number_of_iterations) / seconds;
+  }
+};
+
+const std::string BenchmarkHeader{
+    "search,seed,layout,game_version,aggression,iterations,"
+    "valid_board_fraction,"
+    "iterations_per_second,seconds_to_tolerance,score_imbalance"};
+
+/// \brief Combination that is always generated with the random search and a
+/// fixed seed, and whose time is compared against the baseline. Such
+/// combinations cover cases that once took far longer than the others, for
+/// example because their selected systems could not be placed.
+struct TimedBenchmarkCase {
+  Layout layout;
+
+  GameVersion game_version;
+
+  Aggression aggression;
+
+  uint64_t seed{1};
+};
+
+const std::vector<TimedBenchmarkCase> TimedBenchmarkCases{
+    {Layout::Players4Regular,
+     GameVersion::ProphecyOfKingsAndThundersEdgeExpansions, Aggression::Low, 1},
+    {Layout::Players8Regular,
+     GameVersion::ProphecyOfKingsAndThundersEdgeExpansions, Aggression::Low, 7},
+};
+
+/// \brief Measurements of a combination in the baseline CSV file.
+struct BenchmarkBaseline {
+  double iterations_per_second{0.0};
+
+  double seconds{0.0};
+};
+
+/// \brief Command-line arguments of the benchmark.
+struct BenchmarkArguments {
+  Search search{Search::Annealing};
+
+  uint64_t seed{1};
+
+  /// \brief If nonzero, only the board layouts for this number of players are
+  /// benchmarked.
+  uint8_t number_of_players{0};
+
+  std::string output_path{"ti4bench.csv"};
+
+  std::string baseline_path;
+};
+
+void PrintBenchmarkUsage() noexcept {
+  std::cout
+      << "Usage:" << '\n'
+      << "  ti4bench  --players <number>  --search <type>  --seed <number>  "
+         "--output <path>  --baseline <path>"
+      << '\n'
+      << "Generates one board for each combination of board layout, game "
+         "version, and aggression, and writes the iterations per second, the "
+         "fraction of valid boards, the time to reach the target score "
+         "imbalance, and the final score imbalance of each one to a CSV file. "
+         "Then, a few timed combinations with low aggression are generated "
+         "with the random search and fixed seeds. By default, all numbers of "
+         "players are benchmarked, the search engine is annealing, the seed "
+         "is 1, and the output file is ti4bench.csv. If a baseline CSV file "
+         "from a previous run is given, the iterations per second of each "
+         "combination and the time of each timed combination are compared "
+         "against it."
+      << std::endl;
+}
+
+BenchmarkArguments ParseBenchmarkArguments(int argc, char* argv[]) {
+  BenchmarkArguments arguments;
+  for (int index = 1; index < argc; ++index) {
+    const std::string argument{argv[index]};
+    if (argument == "--help") {
+      PrintBenchmarkUsage();
+      exit(EXIT_SUCCESS);
+    } else if (index + 1 >= argc) {
+      PrintBenchmarkUsage();
+      error("Missing value for argument: " + argument);
+    }
+    const std::string value{argv[++index]};
+    if (argument == "--players") {
+      const int number{std::stoi(value)};
+      if (number < 2 || number > 8) {
+        error("The number of players must be 2-8.");
+      }
+      arguments.number_of_players = static_cast<uint8_t>(number);
+    } else if (argument == "--search") {
+      const std::optional<Search> found{type<Search>(value)};
+      if (!found.has_value()) {
+        error("Unknown search engine: " + value);
+      }
+      arguments.search = found.value();
+    } else if (argument == "--seed") {
+      if (value.empty() || value.front() == '-') {
+        error("Invalid seed: " + value);
+      }
+      arguments.seed = static_cast<uint64_t>(std::stoull(value));
+    } else if (argument == "--output") {
+      arguments.output_path = value;
+    } else if (argument == "--baseline") {
+      arguments.baseline_path = value;
+    } else {
+      PrintBenchmarkUsage();
+      error("Unknown argument: " + argument);
+    }
+  }
+  return arguments;
+}
+
+BenchmarkCase RunBenchmarkCase(
+    const Search search, const uint64_t seed, const Layout layout,
+    const GameVersion game_version, const Aggression aggression) noexcept {
+  Settings settings{game_version, layout, aggression};
+  settings.set_search(search);
+  settings.set_seed(seed);
+  const Chronometre chronometre;
+  const Board board{chronometre, settings};
+  BenchmarkCase benchmark_case{
+      search, seed, layout, game_version, aggression};
+  benchmark_case.seconds = chronometre.value_seconds();
+  benchmark_case.number_of_iterations = board.total_number_of_iterations();
+  benchmark_case.number_of_valid_boards = board.total_number_of_valid_boards();
+  benchmark_case.score_imbalance_ratio = board.final_score_imbalance_ratio();
+  return benchmark_case;
+}
+
+std::string PrintBenchmarkCase(const BenchmarkCase& benchmark_case) noexcept {
+  std::ostringstream stream;
+  stream << benchmark_case.key() << "," << benchmark_case.number_of_iterations
+         << "," << std::fixed << std::setprecision(4)
+         << benchmark_case.valid_board_fraction() << "," << std::setprecision(0)
+         << benchmark_case.iterations_per_second() << ","
+         << std::setprecision(4) << benchmark_case.seconds << ","
+         << benchmark_case.score_imbalance_ratio;
+  return stream.str();
+}
+
+/// \brief Reads the measurements of each combination from a CSV file written
+/// by a previous run.
+std::map<std::string, BenchmarkBaseline> ReadBaseline(const std::string& path) {
+  std::ifstream file{path};
+  if (!file) {
+    error("Cannot open the baseline file: " + path);
+  }
+  std::map<std::string, BenchmarkBaseline> keys_to_baselines;
+  std::string line;
+  std::getline(file, line);
+  while (std::getline(file, line)) {
+    std::vector<std::string> fields;
+    std::istringstream stream{line};
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+      fields.push_back(field);
+    }
+    if (fields.size() >= 9) {
+      keys_to_baselines.emplace(
+          fields[0] + "," + fields[1] + "," + fields[2] + "," + fields[3] + ","
+              + fields[4],
+          BenchmarkBaseline{std::stod(fields[7]), std::stod(fields[8])});
+    }
+  }
+  return keys_to_baselines;
+}
+
+void RunBenchmark(const BenchmarkArguments& arguments) {
+  std::map<std::string, BenchmarkBaseline> baseline;
+  if (!arguments.baseline_path.empty()) {
+    baseline = ReadBaseline(arguments.baseline_path);
+  }
+  std::ofstream output{arguments.output_path};
+  if (!output) {
+    error("Cannot open the output file: " + arguments.output_path);
+  }
+  output << BenchmarkHeader << '\n';
+  std::cout << BenchmarkHeader << '\n';
+  uint32_t number_of_compared_cases{0};
+  double sum_of_logarithms_of_ratios{0.0};
+  for (uint8_t layout_value = 0;
+       layout_value <= static_cast<uint8_t>(Layout::Players8Large);
+       ++layout_value) {
+    const Layout layout{static_cast<Layout>(layout_value)};
+    if (arguments.number_of_players != 0
+        && number_of_players(layout) != arguments.number_of_players) {
+      continue;
+    }
+    for (uint8_t game_version_value = 0;
+         game_version_value <= static_cast<uint8_t>(
+             GameVersion::ProphecyOfKingsAndThundersEdgeExpansions);
+         ++game_version_value) {
+      const GameVersion game_version{
+          static_cast<GameVersion>(game_version_value)};
+      if (!layout_and_game_version_are_compatible(layout, game_version)
+          || !SelectedSystemIds::enough_systems_exist(game_version, layout)) {
+        continue;
+      }
+      for (uint8_t aggression_value = 0;
+           aggression_value <= static_cast<uint8_t>(Aggression::High);
+           ++aggression_value) {
+        const BenchmarkCase benchmark_case{RunBenchmarkCase(
+            arguments.search, arguments.seed, layout, game_version,
+            static_cast<Aggression>(aggression_value))};
+        const std::string text{PrintBenchmarkCase(benchmark_case)};
+        output << text << std::endl;
+        std::cout << text;
+        const std::map<std::string, BenchmarkBaseline>::const_iterator found{
+            baseline.find(benchmark_case.key())};
+        if (found != baseline.cend()
+            && found->second.iterations_per_second > 0.0
+            && benchmark_case.iterations_per_second() > 0.0) {
+          const double ratio{benchmark_case.iterations_per_second()
+                             / found->second.iterations_per_second};
+          ++number_of_compared_cases;
+          sum_of_logarithms_of_ratios += std::log(ratio);
+          std::cout << "  (" << std::fixed << std::setprecision(2) << ratio
+                    << "x baseline)";
+        }
+        std::cout << std::endl;
+      }
+    }
+  }
+  for (const TimedBenchmarkCase& timed_case : TimedBenchmarkCases) {
+    if (arguments.number_of_players != 0
+        && number_of_players(timed_case.layout)
+               != arguments.number_of_players) {
+      continue;
+    }
+    const BenchmarkCase benchmark_case{RunBenchmarkCase(
+        Search::Random, timed_case.seed, timed_case.layout,
+        timed_case.game_version, timed_case.aggression)};
+    const std::string text{PrintBenchmarkCase(benchmark_case)};
+    output << text << std::endl;
+    std::cout << text;
+    const std::map<std::string, BenchmarkBaseline>::const_iterator found{
+        baseline.find(benchmark_case.key())};
+    if (found != baseline.cend() && found->second.seconds > 0.0) {
+      std::cout << "  (" << std::fixed << std::setprecision(2)
+                << benchmark_case.seconds / found->second.seconds
+                << "x baseline time)";
+    }
+    std::cout << std::endl;
+  }
+  if (number_of_compared_cases > 0) {
+    std::cout << "Geometric mean of the iterations per second relative to the "
+                 "baseline over "
+              << number_of_compared_cases << " combinations: " << std::fixed
+              << std::setprecision(3)
+              << std::exp(sum_of_logarithms_of_ratios
+                          / static_cast<double>(number_of_compared_cases))
+              << std::endl;
+  }
+}
+
+}  // namespace TI4Cartographer
+
+int main(int argc, char* argv[]) {
+  TI4Cartographer::Communicator::get().initialize(
+      TI4Cartographer::CommunicatorMode::Silent);
+  const TI4Cartographer::BenchmarkArguments arguments{
+      TI4Cartographer::ParseBenchmarkArguments(argc, argv)};
+  TI4Cartographer::RunBenchmark(arguments);
+  return EXIT_SUCCESS;
+}
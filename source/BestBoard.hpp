@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Player.hpp"
+#include "SystemCatalog.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Best boards found so far by one or more board generation workers.
+/// \details Workers that run in parallel share one instance of this class. A
+/// board is stored compactly as the system index of each placement position,
+/// so recording a better board is a plain array copy. By default, only the best
+/// board is kept. Otherwise, up to a given number of valid boards are kept as
+/// options, best first, and a board that differs from a better option in fewer
+/// than a given number of positions is rejected as a near-duplicate of it. The
+/// score imbalance ratio that must be beaten to be recorded can be read
+/// without locking so that workers can cheaply check whether a board is worth
+/// recording and whether another worker has already met the target score
+/// imbalance.
+class BestBoard {
+public:
+  /// \brief A kept board.
+  struct Option {
+    std::vector<SystemIndex> placement_system_indices;
+
+    std::map<Player, float> player_scores;
+
+    float score_imbalance_ratio{std::numeric_limits<float>::max()};
+  };
+
+  BestBoard(const std::vector<SystemIndex>& placement_system_indices,
+            const std::map<Player, float>& player_scores,
+            const std::size_t number_of_options = 1,
+            const std::size_t minimum_distance = 1) noexcept
+    : fallback_{placement_system_indices, player_scores},
+      number_of_options_(std::max(std::size_t{1}, number_of_options)),
+      minimum_distance_(minimum_distance) {}
+
+  /// \brief Returns true if no board has been recorded yet.
+  bool empty() const noexcept {
+    return !recorded_.load(std::memory_order_relaxed);
+  }
+
+  /// \brief Score imbalance ratio that a board must beat to be recorded: the
+  /// score imbalance ratio of the best board, or, when several options are
+  /// kept, that of the last option once every option is filled. Once it meets
+  /// the target score imbalance, so does every option.
+  float score_imbalance_ratio() const noexcept {
+    return score_imbalance_ratio_.load(std::memory_order_relaxed);
+  }
+
+  /// \brief Records the given board if it is better than the boards found so
+  /// far. Returns true if the given board was recorded. When only the best
+  /// board is kept, an invalid board is recorded like any other. Otherwise, an
+  /// invalid board is only kept as a fallback until a valid board is found.
+  bool update(const std::vector<SystemIndex>& placement_system_indices,
+              const std::map<Player, float>& player_scores,
+              const float score_imbalance_ratio,
+              const bool is_valid = true) noexcept {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    if (number_of_options_ == 1 || !is_valid) {
+      if (score_imbalance_ratio >= fallback_.score_imbalance_ratio
+          || (number_of_options_ > 1 && !options_.empty())) {
+        return false;
+      }
+      std::copy(placement_system_indices.cbegin(),
+                placement_system_indices.cend(),
+                fallback_.placement_system_indices.begin());
+      fallback_.player_scores = player_scores;
+      fallback_.score_imbalance_ratio = score_imbalance_ratio;
+      recorded_.store(true, std::memory_order_relaxed);
+      if (number_of_options_ == 1) {
+        score_imbalance_ratio_.store(score_imbalance_ratio);
+      }
+      return true;
+    }
+    if (options_.size() == number_of_options_
+        && score_imbalance_ratio >= options_.back().score_imbalance_ratio) {
+      return false;
+    }
+    for (const Option& option : options_) {
+      if (option.score_imbalance_ratio <= score_imbalance_ratio
+          && is_near_duplicate(option, placement_system_indices)) {
+        return false;
+      }
+    }
+    // The remaining near-duplicates are all worse than the given board.
+    options_.erase(
+        std::remove_if(options_.begin(), options_.end(),
+                       [&](const Option& option) {
+                         return is_near_duplicate(
+                             option, placement_system_indices);
+                       }),
+        options_.end());
+    options_.insert(
+        std::upper_bound(options_.begin(), options_.end(),
+                         score_imbalance_ratio,
+                         [](const float ratio, const Option& option) {
+                           return ratio < option.score_imbalance_ratio;
+                         }),
+        Option{placement_system_indices, player_scores,
+               score_imbalance_ratio});
+    if (options_.size() > number_of_options_) {
+      options_.pop_back();
+    }
+    recorded_.store(true, std::memory_order_relaxed);
+    score_imbalance_ratio_.store(
+        options_.size() == number_of_options_ ?
+            options_.back().score_imbalance_ratio :
+            std::numeric_limits<float>::max());
+    return true;
+  }
+
+  /// \brief Kept boards, best first. Holds only the best board unless several
+  /// options are kept and a valid board was found. Only call this once all
+  /// workers have finished.
+  std::vector<Option> options() const noexcept {
+    if (number_of_options_ == 1 || options_.empty()) {
+      return {fallback_};
+    }
+    return options_;
+  }
+
+private:
+  std::mutex mutex_;
+
+  /// \brief The best board when only the best board is kept. Otherwise, the
+  /// best invalid board, which is only used if no valid board is found.
+  Option fallback_;
+
+  /// \brief Valid boards kept when several options are kept, best first.
+  std::vector<Option> options_;
+
+  std::size_t number_of_options_{1};
+
+  std::size_t minimum_distance_{1};
+
+  std::atomic<bool> recorded_{false};
+
+  std::atomic<float> score_imbalance_ratio_{std::numeric_limits<float>::max()};
+
+  /// \brief Returns true if the given board differs from the given option in
+  /// fewer positions than the minimum distance.
+  bool is_near_duplicate(const Option& option,
+                         const std::vector<SystemIndex>&
+                             placement_system_indices) const noexcept {
+    std::size_t distance{0};
+    for (std::size_t index = 0;
+         index < placement_system_indices.size()
+         && distance < minimum_distance_;
+         ++index) {
+      if (option.placement_system_indices[index]
+          != placement_system_indices[index]) {
+        ++distance;
+      }
+    }
+    return distance < minimum_distance_;
+  }
+
+};  // class BestBoard
+
+}  // namespace TI4Cartographer
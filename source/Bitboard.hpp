@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Position.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Set of positions on the game board stored as a 64-bit mask in which
+/// each bit corresponds to a position ordinal.
+class Bitboard {
+public:
+  constexpr Bitboard() noexcept {}
+
+  explicit constexpr Bitboard(const uint64_t mask) noexcept : mask_(mask) {}
+
+  uint64_t mask() const noexcept {
+    return mask_;
+  }
+
+  bool empty() const noexcept {
+    return mask_ == 0;
+  }
+
+  uint8_t size() const noexcept {
+    return static_cast<uint8_t>(std::bitset<64>(mask_).count());
+  }
+
+  bool contains(const uint8_t ordinal) const noexcept {
+    return (mask_ >> ordinal) & 1U;
+  }
+
+  bool contains(const Position& position) const noexcept {
+    return contains(position.ordinal());
+  }
+
+  void insert(const uint8_t ordinal) noexcept {
+    mask_ |= uint64_t{1} << ordinal;
+  }
+
+  void insert(const Position& position) noexcept {
+    insert(position.ordinal());
+  }
+
+  void erase(const uint8_t ordinal) noexcept {
+    mask_ &= ~(uint64_t{1} << ordinal);
+  }
+
+  /// \brief Inserts the position if the value is true, or erases it otherwise.
+  void assign(const uint8_t ordinal, const bool value) noexcept {
+    if (value) {
+      insert(ordinal);
+    } else {
+      erase(ordinal);
+    }
+  }
+
+  void clear() noexcept {
+    mask_ = 0;
+  }
+
+  /// \brief Ordinal of the lowest position in this set. Only call this if the
+  /// set is not empty.
+  uint8_t front() const noexcept {
+    return static_cast<uint8_t>(__builtin_ctzll(mask_));
+  }
+
+  /// \brief Removes the lowest position from this set and returns its ordinal.
+  /// Only call this if the set is not empty.
+  uint8_t pop_front() noexcept {
+    const uint8_t ordinal{front()};
+    mask_ &= mask_ - 1;
+    return ordinal;
+  }
+
+  Bitboard operator&(const Bitboard& other) const noexcept {
+    return Bitboard{mask_ & other.mask_};
+  }
+
+  Bitboard operator|(const Bitboard& other) const noexcept {
+    return Bitboard{mask_ | other.mask_};
+  }
+
+  Bitboard& operator&=(const Bitboard& other) noexcept {
+    mask_ &= other.mask_;
+    return *this;
+  }
+
+  Bitboard& operator|=(const Bitboard& other) noexcept {
+    mask_ |= other.mask_;
+    return *this;
+  }
+
+  bool operator==(const Bitboard& other) const noexcept {
+    return mask_ == other.mask_;
+  }
+
+  bool operator!=(const Bitboard& other) const noexcept {
+    return mask_ != other.mask_;
+  }
+
+private:
+  uint64_t mask_{0};
+
+};  // class Bitboard
+
+}  // namespace TI4Cartographer
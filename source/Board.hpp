@@ -1,30 +1,108 @@
 #pragma once
 
+#include "BestBoard.hpp"
 #include "BoardInitializer.hpp"
 #include "Chronometre.hpp"
+#include "Deadline.hpp"
+#include "ExactSearch.hpp"
+#include "GeneticSearch.hpp"
+#include "Lanes.hpp"
+#include "PartitionSearch.hpp"
+#include "RandomStreams.hpp"
+#include "SearchCounters.hpp"
 #include "SelectedSystemIds.hpp"
+#include "Settings.hpp"
+#include "TemperingSearch.hpp"
+#include "TranspositionTable.hpp"
 
 namespace TI4Cartographer {
 
 /// \brief Arrangement of tiles that form a board.
 class Board : public BoardInitializer {
 public:
-  Board(const Chronometre& chronometre, const GameVersion game_version,
-        const Layout layout, const Aggression aggression) noexcept
-    : BoardInitializer(layout) {
+  Board(const Chronometre& chronometre, const Settings& settings) noexcept
+    : BoardInitializer(settings.layout()), search_(settings.search()),
+      number_of_threads_(settings.number_of_threads()),
+      stats_(settings.stats()), random_streams_(settings.seed()) {
     initialize_player_scores();
-    attempt(game_version, layout, aggression);
-    verbose_message("Player scores: " + print_player_scores());
-    verbose_message("Score imbalance: "
-                    + score_imbalance_ratio_to_string(score_imbalance_ratio()));
-    verbose_message("Visualization: " + print_visualization_link());
-    verbose_message(
-        "Tabletop Simulator string: " + print_tabletop_simulator_string());
-    quiet_message(print_tabletop_simulator_string());
-    verbose_message("Runtime: " + chronometre.print());
+    for (uint32_t board_number = 1;
+         board_number <= settings.number_of_boards(); ++board_number) {
+      if (settings.number_of_boards() > 1) {
+        verbose_message("Start of board #" + std::to_string(board_number)
+                        + " of " + std::to_string(settings.number_of_boards())
+                        + ".");
+      }
+      deadline_ = Deadline{settings.time_limit_milliseconds()};
+      attempt(settings, board_number);
+      for (std::size_t index = 0; index < options_.size(); ++index) {
+        if (options_.size() > 1) {
+          verbose_message("Option #" + std::to_string(index + 1) + " of "
+                          + std::to_string(options_.size()) + ":");
+          set_option(index);
+        }
+        verbose_message("Player scores: " + print_player_scores());
+        verbose_message(
+            "Score imbalance: "
+            + score_imbalance_ratio_to_string(score_imbalance_ratio()));
+        verbose_message("Visualization: " + print_visualization_link());
+        verbose_message(
+            "Tabletop Simulator string: " + print_tabletop_simulator_string());
+        quiet_message(print_tabletop_simulator_string());
+      }
+      verbose_message("Runtime: " + chronometre.print());
+      flush_messages();
+      if (StopRequested.load(std::memory_order_relaxed)) {
+        verbose_message("Stopped because a stop signal was received.");
+        break;
+      }
+    }
+    if (stats_) {
+      message(print_search_counter_records());
+      flush_messages();
+    }
+  }
+
+  /// \brief Initializes an empty board of the given layout without generating
+  /// it. Copies of this board can then each generate a board with generate().
+  explicit Board(const Layout layout) noexcept : BoardInitializer(layout) {
+    initialize_player_scores();
+  }
+
+  /// \brief Generates one balanced board and returns its Tabletop Simulator
+  /// string. The settings must use the layout of this board. Nothing is
+  /// printed other than the usual verbose messages.
+  std::string generate(const Settings& settings) noexcept {
+    search_ = settings.search();
+    number_of_threads_ = settings.number_of_threads();
+    stats_ = false;
+    random_streams_ = RandomStreams{settings.seed()};
+    deadline_ = Deadline{settings.time_limit_milliseconds()};
+    attempt(settings, 1);
+    return print_tabletop_simulator_string();
+  }
+
+  /// \brief Total number of search iterations over all boards, attempts, and
+  /// worker threads.
+  uint64_t total_number_of_iterations() const noexcept {
+    return total_number_of_iterations_;
+  }
+
+  /// \brief Total number of search iterations that produced a valid board.
+  uint64_t total_number_of_valid_boards() const noexcept {
+    return total_number_of_valid_boards_;
+  }
+
+  /// \brief Score imbalance of the last generated board.
+  float final_score_imbalance_ratio() const noexcept {
+    return score_imbalance_ratio_;
   }
 
 private:
+  template <typename> friend class ExactSearch;
+  template <typename> friend class GeneticSearch;
+  template <typename> friend class PartitionSearch;
+  template <typename> friend class TemperingSearch;
+
   static constexpr const uint8_t maximum_number_of_attempts_{20};
 
   static constexpr const uint64_t maximum_number_of_iterations_per_attempt_{
@@ -35,25 +113,461 @@ private:
   static constexpr const float score_imbalance_ratio_tolerance_growth_factor_{
       1.3};
 
+  /// \brief A board whose batch score imbalance is within this margin of the
+  /// best score imbalance found so far is rescored exactly. This absorbs the
+  /// rounding differences between the batch scorer and the exact scorer.
+  static constexpr const float batch_score_imbalance_ratio_margin_{1.0e-4f};
+
+  /// \brief The search loops check the deadline once every this many
+  /// iterations, plus one.
+  static constexpr const uint64_t deadline_check_mask_{255};
+
+  /// \brief Number of swaps after which the annealing search reheats to its
+  /// initial temperature.
+  static constexpr const uint64_t annealing_cycle_length_{100000};
+
+  /// \brief Ratio of the final temperature to the initial temperature of each
+  /// annealing cycle.
+  static constexpr const float annealing_final_temperature_ratio_{0.01};
+
+  Search search_{Search::Random};
+
+  /// \brief Number of threads over which the parallel tempering search and the
+  /// genetic search spread their own work.
+  uint16_t number_of_threads_{1};
+
+  /// \brief Deadline of the current board. Once it expires, the search stops
+  /// and the best board found so far is used.
+  Deadline deadline_;
+
+  /// \brief If true, the search engines are instantiated with instrumentation
+  /// that updates the search counters. Otherwise, the instrumentation is
+  /// compiled out.
+  bool stats_{false};
+
+  /// \brief Counters of the current attempt. Mutable so that the validity
+  /// checks, which are const, can update them.
+  mutable SearchCounters search_counters_;
+
+  /// \brief JSON objects of the search counters of each attempt.
+  std::vector<std::string> search_counter_records_;
+
   SelectedSystemIds selected_system_ids_;
 
   std::map<Player, float> player_scores_;
 
   float score_imbalance_ratio_{0.0};
 
+  /// \brief Options of the last generated board, best first.
+  std::vector<BestBoard::Option> options_;
+
+  /// \brief Maximum number of positions that the constructive generator tries
+  /// during one iteration before it gives up on the iteration.
+  static constexpr const uint32_t maximum_number_of_placement_steps_{10000};
+
+  /// \brief Properties of a system that matter to the placement rules.
+  static constexpr const uint8_t placement_anomaly_{SystemContainsAnomaly};
+  static constexpr const uint8_t placement_alpha_wormhole_{
+      SystemContainsAlphaWormhole};
+  static constexpr const uint8_t placement_beta_wormhole_{
+      SystemContainsBetaWormhole};
+  static constexpr const uint8_t placement_wormhole_{SystemContainsWormhole};
+  static constexpr const uint8_t placement_supernova_{SystemContainsSupernova};
+
+  /// \brief A selected system that the constructive generator places.
+  struct PlacementCandidate {
+    SystemIndex system{NoSystemIndex};
+    uint8_t flags{0};
+    bool is_equidistant{false};
+
+    /// \brief Player whose slice this in-slice system must go to, or 0 if it
+    /// can go to any slice.
+    uint8_t slice_player{0};
+  };
+
+  /// \brief Selected systems, with the systems that are subject to the
+  /// placement rules first, most constrained first.
+  std::vector<PlacementCandidate> placement_candidates_;
+
+  /// \brief Number of selected systems that are subject to the placement rules.
+  std::size_t number_of_constrained_placement_candidates_{0};
+
+  /// \brief Player whose slice contains each placement position, indexed by
+  /// placement index, or 0 for an equidistant position.
+  std::vector<uint8_t> placement_slice_players_;
+
+  /// \brief Placement indices of the equidistant positions at index 0, and of
+  /// the slice of each player at the index of that player.
+  std::array<std::vector<uint8_t>, 9> placement_group_indices_;
+
+  /// \brief Equidistant placement positions in random order.
+  std::vector<uint8_t> shuffled_equidistant_placement_indices_;
+
+  /// \brief In-slice placement positions in random order.
+  std::vector<uint8_t> shuffled_in_slice_placement_indices_;
+
+  /// \brief For each constrained candidate placed so far, the index of its
+  /// position within the shuffled placement positions.
+  std::vector<std::size_t> placed_shuffled_indices_;
+
+  /// \brief Placement rule properties of the system placed on each placement
+  /// position so far.
+  std::vector<uint8_t> placed_flags_;
+
+  /// \brief System placed on each placement position so far, or
+  /// NoSystemIndex.
+  std::vector<SystemIndex> placed_systems_;
+
+  /// \brief Number of wormholes placed adjacent to each player's home, indexed
+  /// by player.
+  std::array<uint8_t, 9> placed_wormholes_adjacent_to_homes_{};
+
+  /// \brief Positions of the supernovas placed so far.
+  Bitboard placed_supernova_bitboard_;
+
+  uint32_t number_of_placement_steps_{0};
+
+  /// \brief Number of placements of the current selected systems in a row
+  /// that ran out of steps.
+  uint8_t number_of_exhausted_placements_{0};
+
+  /// \brief Number of placements in a row that run out of steps after which
+  /// the current selected systems are deemed unplaceable.
+  static constexpr const uint8_t maximum_number_of_exhausted_placements_{4};
+
+  /// \brief If true, the current selected systems cannot be placed, and new
+  /// ones are drawn before the next iteration.
+  bool selection_is_unplaceable_{false};
+
+  /// \brief Settings from which the current selected systems were drawn.
+  Settings selection_settings_;
+
+  /// \brief Reusable buffer of the system index of each placement position.
+  std::vector<SystemIndex> placement_system_indices_;
+
+  /// \brief Positions of the placed systems that contain one or more
+  /// anomalies.
+  Bitboard anomaly_bitboard_;
+
+  /// \brief Positions of the placed systems that contain an alpha wormhole.
+  Bitboard alpha_wormhole_bitboard_;
+
+  /// \brief Positions of the placed systems that contain a beta wormhole.
+  Bitboard beta_wormhole_bitboard_;
+
+  /// \brief Positions of the placed systems that contain one or more
+  /// wormholes.
+  Bitboard wormhole_bitboard_;
+
+  /// \brief Positions of the placed systems that contain a supernova.
+  Bitboard supernova_bitboard_;
+
+  /// \brief Weights with which a system placed on a placement position
+  /// contributes to one player's score. The base score term, the preferred and
+  /// alternate expansion position terms, and the systems containing planets
+  /// adjacent to home term are all linear in these weights.
+  struct PlacementScoreWeight {
+    Player player{Player::Player1};
+
+    /// \brief Weight of the system's score.
+    float system{0.0f};
+
+    /// \brief Weight of the system's expansion score.
+    float expansion{0.0f};
+
+    /// \brief Weight of whether the system contains one or more planets.
+    float planets{0.0f};
+  };
+
+  /// \brief For each placement position, the weights of the players whose
+  /// score depends on the system placed there. These are the nonzero columns
+  /// of the dense matrices below, which remain the only source of the weights.
+  /// The incremental and batch scorers visit one placement position at a time,
+  /// and a position only affects a few of the players, so they read this
+  /// sparse form instead of a full column.
+  std::vector<std::vector<PlacementScoreWeight>> placement_score_weights_;
+
+  /// \brief Dense matrix of the weights of the base score term, with one row
+  /// per player, in order of player, and one column per placement position.
+  /// Each weight is the number of relevant players factor times the distance
+  /// factor, or zero if the position is not relevant to the player. Both
+  /// factors only depend on the board layout.
+  std::vector<float> base_score_weights_;
+
+  /// \brief Dense matrix of the number of relevant players factor of each
+  /// placement position, laid out like the base score weights, or zero if the
+  /// position is not relevant to the player. The planets, resources, and
+  /// influence checks are dot products of its rows.
+  std::vector<float> relevant_player_weights_;
+
+  /// \brief Dense matrix of the weights of the preferred expansion position
+  /// term, laid out like the base score weights. Each weight is one over the
+  /// number of preferred expansion positions of the player.
+  std::vector<float> preferred_expansion_weights_;
+
+  /// \brief Dense matrix of the weights of the alternate expansion position
+  /// term, laid out like the base score weights. Each weight is one half over
+  /// the number of alternate expansion positions of the player.
+  std::vector<float> alternate_expansion_weights_;
+
+  /// \brief Dense matrix of the number of times that each placement position
+  /// is a forward or lateral position of each player, laid out like the base
+  /// score weights.
+  std::vector<float> home_adjacency_weights_;
+  /// \brief Reusable buffer of the score of the system on each placement
+  /// position.
+  std::vector<float> placement_scores_;
+
+  /// \brief System currently placed on each placement position, as tracked by
+  /// the incremental scorer.
+  std::vector<SystemIndex> scored_systems_;
+
+  /// \brief Pathway score of the system on each position, indexed by position
+  /// ordinal, as tracked by the incremental scorer.
+  std::array<float, 64> pathway_position_scores_{};
+
+  /// \brief Score of the best pathway to Mecatol Rex of each player, indexed
+  /// by player.
+  std::array<float, 9> best_pathway_scores_{};
+
+  /// \brief Placement index of each position, indexed by position ordinal, or
+  /// NoPlacementIndex if the position is not a placement position.
+  std::array<uint8_t, 64> placement_indices_{};
+
+  static constexpr const uint8_t NoPlacementIndex{
+      std::numeric_limits<uint8_t>::max()};
+
+  /// \brief Number of valid boards currently held by the batch scorer.
+  std::size_t batch_size_{0};
+
+  /// \brief System index of each placement position of each board of the
+  /// batch, indexed by lane.
+  std::array<std::vector<SystemIndex>, Lanes::size> batch_systems_;
+
+  /// \brief Iteration and number of valid boards at which each board of the
+  /// batch was generated, indexed by lane.
+  std::array<std::pair<uint64_t, uint64_t>, Lanes::size> batch_iterations_{};
+
+  /// \brief Zobrist hash of each board of the batch, indexed by lane.
+  std::array<uint64_t, Lanes::size> batch_hashes_{};
+
+  /// \brief Boards already seen by the random search. Shared by every copy of
+  /// this board, including the copies of the worker threads.
+  std::shared_ptr<TranspositionTable> transposition_table_;
+
+  /// \brief Image of each placement position under each symmetry of the board
+  /// layout, as a position ordinal, with one row per placement position and
+  /// one column per symmetry.
+  std::vector<uint8_t> placement_images_;
+
+  /// \brief System score, expansion score, whether it contains planets, and
+  /// pathway score of the system on each placement position of each board of
+  /// the batch. Each is indexed by placement index times the number of lanes
+  /// plus the lane, so that the lanes of a placement position are contiguous.
+  std::vector<float> batch_system_scores_;
+
+  std::vector<float> batch_expansion_scores_;
+
+  std::vector<float> batch_planets_;
+
+  std::vector<float> batch_pathway_scores_;
+
+  uint64_t total_number_of_iterations_{0};
+
+  uint64_t total_number_of_valid_boards_{0};
+
+  /// \brief Source of the seeds of the random engines.
+  RandomStreams random_streams_;
+
+  /// \brief Each board, including each worker's copy of the board, has its own
+  /// random engine so that workers never share random state. It is reseeded
+  /// from its own random stream at the start of each attempt.
+  RandomEngine random_engine_;
+
   void initialize_player_scores() noexcept {
     for (const Player player : players_) {
       player_scores_.insert({player, 0.0});
     }
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      if (placement_is_equidistant_[index]) {
+        shuffled_equidistant_placement_indices_.push_back(
+            static_cast<uint8_t>(index));
+      } else {
+        shuffled_in_slice_placement_indices_.push_back(
+            static_cast<uint8_t>(index));
+      }
+    }
+    placed_flags_.resize(placement_positions_.size());
+    placed_systems_.resize(placement_positions_.size());
+    scored_systems_.resize(placement_positions_.size());
+    placement_scores_.resize(placement_positions_.size());
+    placement_slice_players_.assign(placement_positions_.size(), 0);
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      const std::unordered_map<Position, Player>::const_iterator
+          position_and_player{
+              in_slice_positions_to_players_.find(placement_positions_[index])};
+      if (position_and_player != in_slice_positions_to_players_.cend()) {
+        placement_slice_players_[index] =
+            static_cast<uint8_t>(position_and_player->second);
+      }
+    }
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      placement_group_indices_[placement_slice_players_[index]].push_back(
+          static_cast<uint8_t>(index));
+    }
+    placement_indices_.fill(NoPlacementIndex);
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      placement_indices_[placement_ordinals_[index]] =
+          static_cast<uint8_t>(index);
+    }
+    for (std::vector<SystemIndex>& systems : batch_systems_) {
+      systems.resize(placement_positions_.size());
+    }
+    transposition_table_ = std::make_shared<TranspositionTable>();
+    for (const uint8_t ordinal : placement_ordinals_) {
+      for (const Automorphism& automorphism : automorphisms_) {
+        placement_images_.push_back(automorphism.ordinals[ordinal]);
+      }
+    }
+    batch_system_scores_.resize(placement_positions_.size() * Lanes::size);
+    batch_expansion_scores_.resize(placement_positions_.size() * Lanes::size);
+    batch_planets_.resize(placement_positions_.size() * Lanes::size);
+    batch_pathway_scores_.resize(placement_positions_.size() * Lanes::size);
+    initialize_base_score_weights();
+    initialize_player_weights();
+    initialize_placement_score_weights();
   }
 
-  void attempt(const GameVersion game_version, const Layout layout,
-               const Aggression aggression) noexcept {
+  /// \brief Computes the dense weight matrix of the base score term. This
+  /// matches the factors of the former per-tile calculation: each relevant
+  /// player gains the system's score times the number of relevant players
+  /// factor times the distance factor.
+  void initialize_base_score_weights() noexcept {
+    const std::size_t number_of_positions{placement_positions_.size()};
+    base_score_weights_.assign(players_.size() * number_of_positions, 0.0f);
+    for (std::size_t index = 0; index < number_of_positions; ++index) {
+      const Position& position{placement_positions_[index]};
+      const std::unordered_map<Position, std::map<Player, Distance>>::
+          const_iterator position_and_players_home_distances{
+              positions_to_players_home_distances_.find(position)};
+      const std::unordered_map<Position, std::set<Player>>::const_iterator
+          position_to_relevant_players{
+              positions_to_relevant_players_.find(position)};
+      if (position_and_players_home_distances
+              != positions_to_players_home_distances_.cend()
+          && position_to_relevant_players
+                 != positions_to_relevant_players_.cend()) {
+        const float factor{number_of_relevant_players_factor(
+            position_to_relevant_players->second.size())};
+        for (const Player& player : position_to_relevant_players->second) {
+          const std::map<Player, Distance>::const_iterator player_and_distance{
+              position_and_players_home_distances->second.find(player)};
+          if (player_and_distance
+              != position_and_players_home_distances->second.cend()) {
+            base_score_weights_[player_row(player) * number_of_positions
+                                + index] +=
+                factor * distance_factor(player_and_distance->second);
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Computes the dense weight matrices of the validity checks and of
+  /// the expansion position and home adjacency terms from the layout tables.
+  void initialize_player_weights() noexcept {
+    const std::size_t number_of_positions{placement_positions_.size()};
+    relevant_player_weights_.assign(players_.size() * number_of_positions, 0.0f);
+    preferred_expansion_weights_.assign(
+        players_.size() * number_of_positions, 0.0f);
+    alternate_expansion_weights_.assign(
+        players_.size() * number_of_positions, 0.0f);
+    home_adjacency_weights_.assign(players_.size() * number_of_positions, 0.0f);
+    for (std::size_t index = 0; index < number_of_positions; ++index) {
+      const Position& position{placement_positions_[index]};
+      const std::unordered_map<Position, std::set<Player>>::const_iterator
+          position_to_relevant_players{
+              positions_to_relevant_players_.find(position)};
+      if (position_to_relevant_players
+          != positions_to_relevant_players_.cend()) {
+        const float factor{number_of_relevant_players_factor(
+            position_to_relevant_players->second.size())};
+        for (const Player player : position_to_relevant_players->second) {
+          relevant_player_weights_[player_row(player) * number_of_positions
+                                   + index] = factor;
+        }
+      }
+      for (const Player player : players_) {
+        const std::size_t element{
+            player_row(player) * number_of_positions + index};
+        const Bitboard& preferred_expansion_bitboard{
+            preferred_expansion_bitboards_[static_cast<uint8_t>(player)]};
+        if (preferred_expansion_bitboard.contains(position)) {
+          preferred_expansion_weights_[element] =
+              1.0f / static_cast<float>(preferred_expansion_bitboard.size());
+        }
+        const Bitboard& alternate_expansion_bitboard{
+            alternate_expansion_bitboards_[static_cast<uint8_t>(player)]};
+        if (alternate_expansion_bitboard.contains(position)) {
+          alternate_expansion_weights_[element] =
+              0.5f / static_cast<float>(alternate_expansion_bitboard.size());
+        }
+      }
+      for (const Player& player : placement_home_adjacent_players_[index]) {
+        home_adjacency_weights_[player_row(player) * number_of_positions
+                                + index] += 1.0f;
+      }
+    }
+  }
+
+  /// \brief Dot product of the row of a player in a dense matrix laid out like
+  /// the base score weights and the given values of the placement positions.
+  float player_dot_product(
+      const std::vector<float>& weights, const Player player,
+      const std::array<float, 64>& values) const noexcept {
+    const std::size_t number_of_positions{placement_positions_.size()};
+    const float* row{weights.data() + player_row(player) * number_of_positions};
+    float sum{0.0f};
+    for (std::size_t index = 0; index < number_of_positions; ++index) {
+      sum += row[index] * values[index];
+    }
+    return sum;
+  }
+
+  /// \brief Row of a player in the base score weight matrix.
+  static std::size_t player_row(const Player player) noexcept {
+    return static_cast<std::size_t>(player) - 1;
+  }
+
+  /// \brief Gathers the nonzero weights of the dense matrices for each
+  /// placement position, so that they match the terms of
+  /// calculate_player_scores().
+  void initialize_placement_score_weights() noexcept {
+    const std::size_t number_of_positions{placement_positions_.size()};
+    placement_score_weights_.assign(number_of_positions, {});
+    for (std::size_t index = 0; index < number_of_positions; ++index) {
+      for (const Player player : players_) {
+        const std::size_t element{
+            player_row(player) * number_of_positions + index};
+        const PlacementScoreWeight weight{
+            player, base_score_weights_[element],
+            preferred_expansion_weights_[element]
+                + alternate_expansion_weights_[element],
+            2.0f * home_adjacency_weights_[element]};
+        if (weight.system != 0.0f || weight.expansion != 0.0f
+            || weight.planets != 0.0f) {
+          placement_score_weights_[index].push_back(weight);
+        }
+      }
+    }
+  }
+
+
+  void attempt(const Settings& settings, const uint32_t board_number) noexcept {
     uint8_t number_of_attempts{0};
-    std::unordered_map<Position, Tile> best_positions_to_tiles{
-        positions_to_tiles_};
-    std::map<Player, float> best_player_scores{player_scores_};
-    float best_score_imbalance_ratio{std::numeric_limits<float>::max()};
+    BestBoard best_board{placement_system_indices(), player_scores_,
+                         settings.number_of_options(),
+                         settings.minimum_option_distance()};
     for (uint8_t counter = 0; counter < maximum_number_of_attempts_;
          ++counter) {
       ++number_of_attempts;
@@ -65,46 +579,120 @@ private:
           "Start of board generation attempt #"
           + std::to_string(number_of_attempts) + ": target score imbalance: "
           + score_imbalance_ratio_to_string(score_imbalance_ratio_tolerance));
-      if (best_score_imbalance_ratio <= score_imbalance_ratio_tolerance) {
+      if (best_board.score_imbalance_ratio()
+          <= score_imbalance_ratio_tolerance) {
         verbose_message(
             "Using a previously-found optimal game board because its score "
             "imbalance is now below the target score imbalance.");
         break;
       }
-      initialize_selected_system_ids(game_version, layout, aggression);
-      iterate(score_imbalance_ratio_tolerance, best_positions_to_tiles,
-              best_player_scores, best_score_imbalance_ratio);
+      search_counters_ = {};
+      // The parallel tempering search and the genetic search spread their own
+      // work over the threads.
+      if (settings.number_of_threads() <= 1 || search_ == Search::Tempering
+          || search_ == Search::Genetic) {
+        random_engine_.seed(
+            random_streams_.stream_seed(board_number, counter, 0));
+        initialize_selected_system_ids(settings);
+        search(score_imbalance_ratio_tolerance, best_board);
+      } else {
+        iterate_in_parallel(settings, board_number, counter,
+                            score_imbalance_ratio_tolerance, best_board);
+      }
+      if (stats_) {
+        search_counter_records_.push_back(
+            "{\"board\":" + std::to_string(board_number) + ",\"attempt\":"
+            + std::to_string(number_of_attempts)
+            + ",\"counters\":" + search_counters_.print_json() + "}");
+      }
       verbose_message("End of board generation attempt #"
                       + std::to_string(number_of_attempts) + ".");
-      if (score_imbalance_ratio_ <= score_imbalance_ratio_tolerance) {
+      if (deadline_.expired()) {
+        verbose_message("Using the best game board found so far because the "
+                        "time limit was reached or a stop was requested.");
+        break;
+      }
+      // The exact search already found the best board for its selected
+      // systems, so a looser target score imbalance cannot change its result.
+      if (search_ == Search::Exact) {
+        break;
+      }
+      if (best_board.score_imbalance_ratio()
+          <= score_imbalance_ratio_tolerance) {
         break;
       }
     }
-    positions_to_tiles_ = best_positions_to_tiles;
-    player_scores_ = best_player_scores;
-    score_imbalance_ratio_ = best_score_imbalance_ratio;
+    options_ = best_board.options();
+    set_option(0);
+  }
+
+  /// \brief Places the given option of the last generated board on the tiles.
+  void set_option(const std::size_t index) {
+    const BestBoard::Option& option{options_[index]};
+    set_placement_system_indices(option.placement_system_indices);
+    player_scores_ = option.player_scores;
+    score_imbalance_ratio_ = option.score_imbalance_ratio;
+  }
+
+  /// \brief Runs one attempt on several worker threads. Each worker is an
+  /// independent copy of this board with its own selected systems and its own
+  /// random engine. All workers share the best board found so far and stop as
+  /// soon as any one of them meets the target score imbalance.
+  void iterate_in_parallel(const Settings& settings,
+                           const uint32_t board_number,
+                           const uint8_t attempt_number,
+                           const float score_imbalance_ratio_tolerance,
+                           BestBoard& best_board) {
+    std::vector<Board> workers(settings.number_of_threads(), *this);
+    for (std::size_t worker_index = 0; worker_index < workers.size();
+         ++worker_index) {
+      Board& worker{workers[worker_index]};
+      worker.random_engine_.seed(random_streams_.stream_seed(
+          board_number, attempt_number,
+          static_cast<uint16_t>(worker_index + 1)));
+      worker.total_number_of_iterations_ = 0;
+      worker.total_number_of_valid_boards_ = 0;
+      worker.search_counters_ = {};
+      worker.initialize_selected_system_ids(settings);
+    }
+    std::vector<std::thread> threads;
+    for (Board& worker : workers) {
+      threads.emplace_back(
+          [&worker, score_imbalance_ratio_tolerance, &best_board]() {
+            worker.search(score_imbalance_ratio_tolerance, best_board);
+          });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    for (const Board& worker : workers) {
+      total_number_of_iterations_ += worker.total_number_of_iterations_;
+      total_number_of_valid_boards_ += worker.total_number_of_valid_boards_;
+      search_counters_ += worker.search_counters_;
+    }
   }
 
-  void initialize_selected_system_ids(
-      const GameVersion game_version, const Layout layout,
-      const Aggression aggression) noexcept {
+  void initialize_selected_system_ids(const Settings& settings) noexcept {
+    selection_settings_ = settings;
+    number_of_exhausted_placements_ = 0;
+    selection_is_unplaceable_ = false;
     selected_system_ids_ = {
-        game_version, layout, aggression,
-        static_cast<uint8_t>(equidistant_positions_.size())};
+        settings.game_version(), settings.layout(), settings.aggression(),
+        static_cast<uint8_t>(equidistant_positions_.size()), random_engine_};
+    initialize_placement_candidates();
     // Check that the number of selected systems matches the number of
     // planetary/anomaly/wormhole/empty tiles.
     uint8_t number_of_planetary_anomaly_wormhole_empty_tiles{0};
     uint8_t number_of_equidistant_positions{0};
     uint8_t number_of_in_slice_positions{0};
-    for (const std::pair<const Position, Tile>& position_and_tile :
-         positions_to_tiles_) {
-      if (position_and_tile.second.is_planetary_anomaly_wormhole_or_empty()) {
+    for (const Tile& tile : positions_to_tiles_) {
+      if (tile.is_planetary_anomaly_wormhole_or_empty()) {
         ++number_of_planetary_anomaly_wormhole_empty_tiles;
       }
-      if (in_slice_positions_to_players_.find(position_and_tile.first)
+      if (in_slice_positions_to_players_.find(tile.position())
           != in_slice_positions_to_players_.cend()) {
         ++number_of_in_slice_positions;
-      } else if (equidistant_positions_.find(position_and_tile.first)
+      } else if (equidistant_positions_.find(tile.position())
                  != equidistant_positions_.cend()) {
         ++number_of_equidistant_positions;
       }
@@ -131,49 +719,191 @@ private:
     }
   }
 
-  void iterate(const float score_imbalance_ratio_tolerance,
-               std::unordered_map<Position, Tile>& best_positions_to_tiles,
-               std::map<Player, float>& best_player_scores,
-               float& best_score_imbalance_ratio) {
+  /// \brief Searches for a board that meets the target score imbalance using
+  /// the selected search engine.
+  void search(
+      const float score_imbalance_ratio_tolerance, BestBoard& best_board) {
+    switch (search_) {
+      case Search::Random:
+        if (stats_) {
+          iterate<true>(score_imbalance_ratio_tolerance, best_board);
+        } else {
+          iterate<false>(score_imbalance_ratio_tolerance, best_board);
+        }
+        break;
+      case Search::Annealing:
+        if (stats_) {
+          anneal<true>(score_imbalance_ratio_tolerance, best_board);
+        } else {
+          anneal<false>(score_imbalance_ratio_tolerance, best_board);
+        }
+        break;
+      case Search::Exact:
+        if (stats_) {
+          ExactSearch<Board>{*this}.run<true>(
+              score_imbalance_ratio_tolerance, best_board);
+        } else {
+          ExactSearch<Board>{*this}.run<false>(
+              score_imbalance_ratio_tolerance, best_board);
+        }
+        break;
+      case Search::Partition:
+        if (stats_) {
+          PartitionSearch<Board>{*this}.run<true>(
+              score_imbalance_ratio_tolerance, best_board);
+        } else {
+          PartitionSearch<Board>{*this}.run<false>(
+              score_imbalance_ratio_tolerance, best_board);
+        }
+        break;
+      case Search::Tempering:
+        if (stats_) {
+          TemperingSearch<Board>{*this}.run<true>(
+              score_imbalance_ratio_tolerance, best_board);
+        } else {
+          TemperingSearch<Board>{*this}.run<false>(
+              score_imbalance_ratio_tolerance, best_board);
+        }
+        break;
+      case Search::Genetic:
+        if (stats_) {
+          GeneticSearch<Board>{*this}.run<true>(
+              score_imbalance_ratio_tolerance, best_board);
+        } else {
+          GeneticSearch<Board>{*this}.run<false>(
+              score_imbalance_ratio_tolerance, best_board);
+        }
+        break;
+    }
+  }
+
+  /// \brief Evaluates a validity check. When instrumented, also records its
+  /// outcome and its duration in the search counters.
+  template <bool Instrumented, typename Check>
+  bool passes(
+      const ValidityCheck validity_check, const Check& check) const noexcept {
+    if constexpr (Instrumented) {
+      const std::chrono::steady_clock::time_point start{
+          std::chrono::steady_clock::now()};
+      const bool passed{check()};
+      search_counters_.record(
+          validity_check, passed, SearchCounters::nanoseconds_since(start));
+      return passed;
+    } else {
+      return check();
+    }
+  }
+
+  /// \brief Evaluates a scoring term. When instrumented, also records its
+  /// duration in the search counters.
+  template <bool Instrumented, typename Term>
+  void evaluate(const ScoringTerm scoring_term, const Term& term) noexcept {
+    if constexpr (Instrumented) {
+      const std::chrono::steady_clock::time_point start{
+          std::chrono::steady_clock::now()};
+      term();
+      search_counters_.record(
+          scoring_term, SearchCounters::nanoseconds_since(start));
+    } else {
+      term();
+    }
+  }
+
+  template <bool Instrumented>
+  void iterate(
+      const float score_imbalance_ratio_tolerance, BestBoard& best_board) {
     uint64_t number_of_iterations{0};
     uint64_t number_of_valid_boards{0};
     bool success{false};
+    bool stopped_by_another_worker{false};
+    bool stopped_by_deadline{false};
     // The first iteration of the first attempt is always recorded as a "best"
     // iteration.
-    if (best_score_imbalance_ratio == std::numeric_limits<float>::max()) {
+    if (best_board.empty()) {
       ++number_of_iterations;
-      const bool board_is_valid = assign_system_ids_to_tiles();
+      const bool board_is_valid = place_system_ids_on_tiles<Instrumented>();
       if (board_is_valid) {
         ++number_of_valid_boards;
       }
-      calculate_player_scores();
+      calculate_player_scores<Instrumented>();
       score_imbalance_ratio_ = score_imbalance_ratio();
       success = update_best_board_and_return_success(
-          score_imbalance_ratio_tolerance, best_positions_to_tiles,
-          best_player_scores, best_score_imbalance_ratio, number_of_iterations);
+          score_imbalance_ratio_tolerance, best_board, number_of_iterations,
+          board_is_valid);
     }
     // Iterate.
     if (!success) {
       for (uint64_t counter = number_of_iterations;
            counter < maximum_number_of_iterations_per_attempt_; ++counter) {
+        if (best_board.score_imbalance_ratio()
+            <= score_imbalance_ratio_tolerance) {
+          // Another worker has already found an optimal game board.
+          stopped_by_another_worker = true;
+          break;
+        }
+        if ((counter & deadline_check_mask_) == 0 && deadline_.expired()) {
+          stopped_by_deadline = true;
+          break;
+        }
         ++number_of_iterations;
-        selected_system_ids_.shuffle();
-        const bool board_is_valid = assign_system_ids_to_tiles();
-        if (board_is_valid) {
+        shuffle_selected_system_ids();
+        bool board_is_valid{false};
+        uint64_t hash{0};
+        if (place_candidates<Instrumented>()) {
+          // A board that was already seen is only scored again if it may
+          // improve on the best board found so far, which only happens when a
+          // previous board left it in the table.
+          hash = zobrist_hash();
+          const std::optional<TranspositionTable::Entry> entry{
+              transposition_table_->probe(hash)};
+          if constexpr (Instrumented) {
+            search_counters_.record_transposition_probe(entry.has_value());
+          }
+          if (entry.has_value()) {
+            if (!entry->is_valid) {
+              continue;
+            }
+            if (entry->score_imbalance_ratio
+                    - batch_score_imbalance_ratio_margin_
+                >= best_board.score_imbalance_ratio()) {
+              ++number_of_valid_boards;
+              continue;
+            }
+            board_is_valid = true;
+          } else {
+            board_is_valid = placed_board_is_valid<Instrumented>();
+          }
+        } else {
+          board_is_valid = assign_system_ids_to_tiles<Instrumented>();
+          hash = zobrist_hash();
+        }
+        if (!board_is_valid) {
+          transposition_table_->store(hash, {});
+        } else {
           ++number_of_valid_boards;
-          calculate_player_scores();
-          score_imbalance_ratio_ = score_imbalance_ratio();
-          if (score_imbalance_ratio_ < best_score_imbalance_ratio) {
-            success = update_best_board_and_return_success(
-                score_imbalance_ratio_tolerance, best_positions_to_tiles,
-                best_player_scores, best_score_imbalance_ratio,
-                number_of_iterations);
+          add_to_batch(number_of_iterations, number_of_valid_boards, hash);
+          if (batch_size_ == Lanes::size) {
+            success = score_batch_and_return_success<Instrumented>(
+                score_imbalance_ratio_tolerance, best_board,
+                number_of_iterations, number_of_valid_boards);
             if (success) {
               break;
             }
           }
         }
       }
+      // Score the boards that remain in a partially-filled batch.
+      if (!success && batch_size_ > 0) {
+        success = score_batch_and_return_success<Instrumented>(
+            score_imbalance_ratio_tolerance, best_board, number_of_iterations,
+            number_of_valid_boards);
+      }
+    }
+    total_number_of_iterations_ += number_of_iterations;
+    total_number_of_valid_boards_ += number_of_valid_boards;
+    if constexpr (Instrumented) {
+      search_counters_.add_iterations(
+          number_of_iterations, number_of_valid_boards);
     }
     // Message after iterations are complete.
     if (success) {
@@ -182,6 +912,20 @@ private:
           + std::to_string(number_of_iterations)
           + " iterations which generated "
           + std::to_string(number_of_valid_boards) + " valid game boards.");
+    } else if (stopped_by_another_worker) {
+      verbose_message(
+          "Stopped after " + std::to_string(number_of_iterations)
+          + " iterations which generated "
+          + std::to_string(number_of_valid_boards)
+          + " valid game boards because another worker found an optimal game "
+            "board.");
+    } else if (stopped_by_deadline) {
+      verbose_message(
+          "Stopped after " + std::to_string(number_of_iterations)
+          + " iterations which generated "
+          + std::to_string(number_of_valid_boards)
+          + " valid game boards because the time limit was reached or a stop "
+            "was requested.");
     } else {
       verbose_message(
           "No optimal game board with a score imbalance of "
@@ -193,71 +937,589 @@ private:
     }
   }
 
-  bool update_best_board_and_return_success(
-      const float score_imbalance_ratio_tolerance,
-      std::unordered_map<Position, Tile>& best_positions_to_tiles,
-      std::map<Player, float>& best_player_scores,
-      float& best_score_imbalance_ratio,
-      const uint64_t number_of_iterations) noexcept {
-    best_positions_to_tiles = positions_to_tiles_;
-    best_player_scores = player_scores_;
-    best_score_imbalance_ratio = score_imbalance_ratio_;
-    verbose_message("Iteration " + std::to_string(number_of_iterations)
-                    + ": Score imbalance: "
-                    + score_imbalance_ratio_to_string(score_imbalance_ratio_));
-    if (score_imbalance_ratio_ <= score_imbalance_ratio_tolerance) {
-      return true;
+  /// \brief Simulated annealing. Starts from a valid board and repeatedly
+  /// swaps the systems of two equidistant positions or of two in-slice
+  /// positions. Swaps that produce an invalid board are rejected. Otherwise, a
+  /// swap that lowers the score imbalance is always accepted, and a swap that
+  /// raises it is accepted with a probability that decreases as the
+  /// temperature decreases. The temperature starts at the target score
+  /// imbalance and decreases geometrically over each cycle, after which it is
+  /// reheated.
+  template <bool Instrumented>
+  void anneal(
+      const float score_imbalance_ratio_tolerance, BestBoard& best_board) {
+    uint64_t number_of_iterations{0};
+    uint64_t number_of_valid_boards{0};
+    uint64_t number_of_accepted_swaps{0};
+    bool success{false};
+    bool stopped_by_another_worker{false};
+    bool stopped_by_deadline{false};
+    // Start from a valid board.
+    const bool board_is_valid{generate_valid_board<Instrumented>(
+        maximum_number_of_iterations_per_attempt_, number_of_iterations,
+        stopped_by_deadline)};
+    if (board_is_valid) {
+      ++number_of_valid_boards;
+    }
+    if (board_is_valid || best_board.empty()) {
+      success = update_best_board_and_return_success(
+          score_imbalance_ratio_tolerance, best_board, number_of_iterations,
+          board_is_valid);
+    }
+    float current_score_imbalance_ratio{score_imbalance_ratio_};
+    const float initial_temperature{score_imbalance_ratio_tolerance};
+    const float cooling_factor{std::pow(
+        annealing_final_temperature_ratio_,
+        1.0f / static_cast<float>(annealing_cycle_length_))};
+    float temperature{initial_temperature};
+    while (board_is_valid && !success
+           && number_of_iterations
+                  < maximum_number_of_iterations_per_attempt_) {
+      if (best_board.score_imbalance_ratio()
+          <= score_imbalance_ratio_tolerance) {
+        stopped_by_another_worker = true;
+        break;
+      }
+      if ((number_of_iterations & deadline_check_mask_) == 0
+          && deadline_.expired()) {
+        stopped_by_deadline = true;
+        break;
+      }
+      ++number_of_iterations;
+      if (number_of_iterations % annealing_cycle_length_ == 0) {
+        temperature = initial_temperature;
+        // Discard any floating-point drift of the incremental scorer.
+        initialize_incremental_player_scores();
+        current_score_imbalance_ratio = score_imbalance_ratio();
+      } else {
+        temperature *= cooling_factor;
+      }
+      const std::pair<uint8_t, uint8_t> indices{random_swap()};
+      swap_system_ids_and_update_player_scores<Instrumented>(
+          indices.first, indices.second);
+      if (!iteration_is_valid<Instrumented>()) {
+        swap_system_ids_and_update_player_scores<Instrumented>(
+            indices.first, indices.second);
+        continue;
+      }
+      ++number_of_valid_boards;
+      score_imbalance_ratio_ = score_imbalance_ratio();
+      if (score_imbalance_ratio_ <= current_score_imbalance_ratio
+          || random_engine_.uniform()
+                 < std::exp((current_score_imbalance_ratio
+                             - score_imbalance_ratio_)
+                            / temperature)) {
+        ++number_of_accepted_swaps;
+        current_score_imbalance_ratio = score_imbalance_ratio_;
+        if (score_imbalance_ratio_ < best_board.score_imbalance_ratio()) {
+          success = update_best_board_and_return_success(
+              score_imbalance_ratio_tolerance, best_board,
+              number_of_iterations);
+        }
+      } else {
+        swap_system_ids_and_update_player_scores<Instrumented>(
+            indices.first, indices.second);
+      }
+    }
+    total_number_of_iterations_ += number_of_iterations;
+    total_number_of_valid_boards_ += number_of_valid_boards;
+    if constexpr (Instrumented) {
+      search_counters_.add_iterations(
+          number_of_iterations, number_of_valid_boards);
+    }
+    // Message after iterations are complete.
+    const std::string summary{
+        std::to_string(number_of_iterations) + " iterations with "
+        + std::to_string(number_of_accepted_swaps) + " accepted swaps"};
+    if (success) {
+      verbose_message("Found an optimal game board after " + summary + ".");
+    } else if (stopped_by_another_worker) {
+      verbose_message("Stopped after " + summary
+                      + " because another worker found an optimal game "
+                        "board.");
+    } else if (stopped_by_deadline) {
+      verbose_message("Stopped after " + summary
+                      + " because the time limit was reached or a stop was "
+                        "requested.");
+    } else if (!board_is_valid) {
+      verbose_message("No valid game board could be found after "
+                      + std::to_string(number_of_iterations) + " iterations.");
     } else {
-      return false;
+      verbose_message(
+          "No optimal game board with a score imbalance of "
+          + score_imbalance_ratio_to_string(score_imbalance_ratio_tolerance)
+          + " or less could be found after " + summary + ".");
+    }
+  }
+
+  /// \brief Generates random boards until one is valid or until the given
+  /// maximum number of iterations is reached, then initializes the incremental
+  /// scorer from the last board generated. Returns true if that board is
+  /// valid.
+  template <bool Instrumented>
+  bool generate_valid_board(const uint64_t maximum_number_of_iterations,
+                            uint64_t& number_of_iterations,
+                            bool& stopped_by_deadline) {
+    bool board_is_valid{false};
+    while (!board_is_valid
+           && number_of_iterations < maximum_number_of_iterations) {
+      if ((number_of_iterations & deadline_check_mask_) == 0
+          && number_of_iterations > 0 && deadline_.expired()) {
+        stopped_by_deadline = true;
+        break;
+      }
+      ++number_of_iterations;
+      shuffle_selected_system_ids();
+      board_is_valid = place_system_ids_on_tiles<Instrumented>();
+    }
+    initialize_incremental_player_scores();
+    score_imbalance_ratio_ = score_imbalance_ratio();
+    return board_is_valid;
+  }
+
+  /// \brief Randomly chooses two equidistant placement positions or two
+  /// in-slice placement positions. Larger groups are chosen more often.
+  std::pair<uint8_t, uint8_t> random_swap() noexcept {
+    const std::size_t number_of_equidistant{
+        shuffled_equidistant_placement_indices_.size()};
+    const std::size_t number_of_in_slice{
+        shuffled_in_slice_placement_indices_.size()};
+    const bool choose_equidistant{
+        number_of_in_slice < 2
+        || (number_of_equidistant >= 2
+            && random_engine_.below(static_cast<uint32_t>(
+                   number_of_equidistant + number_of_in_slice))
+                   < number_of_equidistant)};
+    const std::vector<uint8_t>& indices{
+        choose_equidistant ? shuffled_equidistant_placement_indices_ :
+                             shuffled_in_slice_placement_indices_};
+    const uint32_t size{static_cast<uint32_t>(indices.size())};
+    const uint32_t first{random_engine_.below(size)};
+    uint32_t second{random_engine_.below(size - 1)};
+    if (second >= first) {
+      ++second;
+    }
+    return {indices[first], indices[second]};
+  }
+
+  /// \brief Swaps the systems of two placement positions, including their
+  /// system bitboards.
+  void swap_system_ids(const uint8_t index_1, const uint8_t index_2) {
+    const uint8_t flags_1{system_bitboard_flags(index_1)};
+    update_system_bitboards(index_1, system_bitboard_flags(index_2));
+    update_system_bitboards(index_2, flags_1);
+    Tile& tile_1{*positions_to_tiles_.find(placement_positions_[index_1])};
+    Tile& tile_2{*positions_to_tiles_.find(placement_positions_[index_2])};
+    const SystemIndex system_1{tile_1.system_index()};
+    tile_1.set_system_index(tile_2.system_index());
+    tile_2.set_system_index(system_1);
+  }
+
+  /// \brief Placement flags of the system on a placement position, as recorded
+  /// in the system bitboards.
+  uint8_t system_bitboard_flags(const uint8_t index) const noexcept {
+    const uint8_t ordinal{placement_ordinals_[index]};
+    uint8_t flags{0};
+    if (anomaly_bitboard_.contains(ordinal)) {
+      flags |= placement_anomaly_;
+    }
+    if (alpha_wormhole_bitboard_.contains(ordinal)) {
+      flags |= placement_alpha_wormhole_;
+    }
+    if (beta_wormhole_bitboard_.contains(ordinal)) {
+      flags |= placement_beta_wormhole_;
+    }
+    if (wormhole_bitboard_.contains(ordinal)) {
+      flags |= placement_wormhole_;
+    }
+    if (supernova_bitboard_.contains(ordinal)) {
+      flags |= placement_supernova_;
+    }
+    return flags;
+  }
+
+  /// \brief Records the placement flags of the system on a placement position
+  /// in the system bitboards.
+  void update_system_bitboards(
+      const uint8_t index, const uint8_t flags) noexcept {
+    const uint8_t ordinal{placement_ordinals_[index]};
+    anomaly_bitboard_.assign(ordinal, flags & placement_anomaly_);
+    alpha_wormhole_bitboard_.assign(ordinal, flags & placement_alpha_wormhole_);
+    beta_wormhole_bitboard_.assign(ordinal, flags & placement_beta_wormhole_);
+    wormhole_bitboard_.assign(ordinal, flags & placement_wormhole_);
+    supernova_bitboard_.assign(ordinal, flags & placement_supernova_);
+  }
+
+  /// \brief Records the board in the best boards. Returns true if the best
+  /// boards now meet the target score imbalance, in which case so does this
+  /// board.
+  bool update_best_board_and_return_success(
+      const float score_imbalance_ratio_tolerance, BestBoard& best_board,
+      const uint64_t number_of_iterations, const bool is_valid = true) noexcept {
+    if (best_board.update(
+            placement_system_indices(), player_scores_,
+            score_imbalance_ratio_, is_valid)) {
+      verbose_message(
+          "Iteration " + std::to_string(number_of_iterations)
+          + ": Score imbalance: "
+          + score_imbalance_ratio_to_string(score_imbalance_ratio_));
+    }
+    return score_imbalance_ratio_ <= score_imbalance_ratio_tolerance
+           && best_board.score_imbalance_ratio()
+                  <= score_imbalance_ratio_tolerance;
+  }
+
+  /// \brief Returns the system index of each placement position.
+  const std::vector<SystemIndex>& placement_system_indices() noexcept {
+    placement_system_indices_.resize(placement_positions_.size());
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      placement_system_indices_[index] =
+          positions_to_tiles_.find(placement_positions_[index])->system_index();
+    }
+    return placement_system_indices_;
+  }
+
+  /// \brief Zobrist hash of the systems on the placement positions, in the
+  /// canonical form of the board under the symmetries of the board layout: the
+  /// smallest hash of the images of the board. Boards that are equivalent by a
+  /// symmetry have equal scores up to a permutation of the players, so they
+  /// share one entry of the transposition table.
+  uint64_t zobrist_hash() const noexcept {
+    // The hashes of all images are computed together, which keeps their
+    // independent chains of exclusive ors in flight at once.
+    const std::size_t number_of_automorphisms{automorphisms_.size()};
+    std::array<uint64_t, 12> hashes{};
+    const uint8_t* images{placement_images_.data()};
+    for (const uint8_t ordinal : placement_ordinals_) {
+      const SystemIndex system{positions_to_tiles_.find(ordinal)->system_index()};
+      for (std::size_t automorphism = 0;
+           automorphism < number_of_automorphisms; ++automorphism) {
+        hashes[automorphism] ^=
+            transposition_table_->key(images[automorphism], system);
+      }
+      images += number_of_automorphisms;
+    }
+    return *std::min_element(
+        hashes.cbegin(), hashes.cbegin() + number_of_automorphisms);
+  }
+
+  /// \brief Places the given system index on each placement position.
+  void set_placement_system_indices(
+      const std::vector<SystemIndex>& placement_system_indices) {
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      positions_to_tiles_.find(placement_positions_[index])
+          ->set_system_index(placement_system_indices[index]);
     }
   }
 
   /// \brief Assigns system IDs in a simple manner. Returns true if the board is
   /// valid and false otherwise. Most boards are invalid with this method.
+  template <bool Instrumented = false>
   bool assign_system_ids_to_tiles() {
     uint8_t equidistant_system_ids_index{0};
     uint8_t in_slice_system_ids_index{0};
-    for (std::unordered_map<Position, Tile>::iterator position_and_tile =
-             positions_to_tiles_.begin();
-         position_and_tile != positions_to_tiles_.end(); ++position_and_tile) {
-      if (position_and_tile->second.is_planetary_anomaly_wormhole_or_empty()) {
-        if (equidistant_positions_.find(position_and_tile->first)
+    for (Tile& tile : positions_to_tiles_) {
+      if (tile.is_planetary_anomaly_wormhole_or_empty()) {
+        if (equidistant_positions_.find(tile.position())
             != equidistant_positions_.cend()) {
-          position_and_tile->second.set_system_id(
+          tile.set_system_index(
               selected_system_ids_.equidistant()[equidistant_system_ids_index]);
           ++equidistant_system_ids_index;
         } else {
-          position_and_tile->second.set_system_id(
+          tile.set_system_index(
               selected_system_ids_.in_slice()[in_slice_system_ids_index]);
           ++in_slice_system_ids_index;
         }
       }
     }
-    return iteration_is_valid();
+    for (uint8_t index = 0; index < placement_positions_.size(); ++index) {
+      update_system_bitboards(
+          index, placement_flags(
+                     positions_to_tiles_.find(placement_positions_[index])
+                         ->system_index()));
+    }
+    return iteration_is_valid<Instrumented>();
+  }
+
+  /// \brief Places the selected system IDs on the tiles while enforcing the
+  /// adjacent anomalies and wormholes rule, the supernova rule for pathways to
+  /// Mecatol Rex, and the wormholes adjacent to homes rule. Only systems that
+  /// contain anomalies or wormholes are subject to these rules, so these are
+  /// placed first, one at a time, on randomly-ordered positions, backtracking
+  /// whenever a system has no suitable position left. The remaining systems
+  /// then fill the remaining positions in random order. Only the planets,
+  /// resources, and influence requirements are checked afterwards. Returns true
+  /// if the board is valid. If no placement is found within the step budget,
+  /// the system IDs are assigned in the simple manner instead so that every
+  /// tile still holds a system.
+  template <bool Instrumented = false>
+  bool place_system_ids_on_tiles() {
+    if (!place_candidates<Instrumented>()) {
+      return assign_system_ids_to_tiles<Instrumented>();
+    }
+    return placed_board_is_valid<Instrumented>();
+  }
+
+  /// \brief First part of place_system_ids_on_tiles(): places the selected
+  /// system IDs on the tiles while enforcing the placement rules. Returns
+  /// false if no placement is found within the step budget, in which case the
+  /// tiles are left unchanged.
+  template <bool Instrumented = false>
+  bool place_candidates() {
+    random_engine_.shuffle(shuffled_equidistant_placement_indices_);
+    random_engine_.shuffle(shuffled_in_slice_placement_indices_);
+    std::fill(placed_flags_.begin(), placed_flags_.end(), 0);
+    std::fill(placed_systems_.begin(), placed_systems_.end(), NoSystemIndex);
+    placed_wormholes_adjacent_to_homes_.fill(0);
+    placed_supernova_bitboard_.clear();
+    number_of_placement_steps_ = 0;
+    if (!passes<Instrumented>(ValidityCheck::ConstrainedPlacement, [this]() {
+          return place_constrained_candidates(0);
+        })) {
+      record_failed_placement();
+      return false;
+    }
+    number_of_exhausted_placements_ = 0;
+    place_unconstrained_candidates();
+    for (uint8_t index = 0; index < placement_positions_.size(); ++index) {
+      positions_to_tiles_.find(placement_positions_[index])
+          ->set_system_index(placed_systems_[index]);
+      update_system_bitboards(index, placed_flags_[index]);
+    }
+    return true;
+  }
+
+  /// \brief Records that the constrained candidates could not be placed. If
+  /// the backtracking ended within the step budget, no placement exists, so
+  /// unless the partition search restricted the candidates to slices, the
+  /// selected systems cannot be placed at all. The selected systems are also
+  /// deemed unplaceable once the step budget runs out too many times in a row.
+  /// Either way, new selected systems are drawn before the next iteration
+  /// instead of spending the step budget again on every iteration.
+  void record_failed_placement() noexcept {
+    if (number_of_placement_steps_ > maximum_number_of_placement_steps_) {
+      if (++number_of_exhausted_placements_
+          >= maximum_number_of_exhausted_placements_) {
+        selection_is_unplaceable_ = true;
+      }
+      return;
+    }
+    if (std::none_of(placement_candidates_.cbegin(),
+                     placement_candidates_.cend(),
+                     [](const PlacementCandidate& candidate) {
+                       return candidate.slice_player != 0;
+                     })) {
+      selection_is_unplaceable_ = true;
+    }
+  }
+
+  /// \brief Shuffles the selected systems before an iteration, after drawing
+  /// new selected systems if the current ones cannot be placed.
+  void shuffle_selected_system_ids() noexcept {
+    if (selection_is_unplaceable_) {
+      initialize_selected_system_ids(selection_settings_);
+    }
+    selected_system_ids_.shuffle(random_engine_);
+  }
+
+  /// \brief Second part of place_system_ids_on_tiles(): the placement rules
+  /// already hold, so only the planets, resources, and influence requirements
+  /// are checked.
+  template <bool Instrumented = false>
+  bool placed_board_is_valid() const noexcept {
+    return passes<Instrumented>(
+               ValidityCheck::EnoughPlanets,
+               [this]() { return players_have_enough_planets(); })
+           && passes<Instrumented>(
+               ValidityCheck::EnoughUsefulResourcesAndUsefulInfluence,
+               [this]() {
+                 return players_have_enough_useful_resources_and_useful_influence();
+               });
+  }
+
+  void initialize_placement_candidates() noexcept {
+    placement_candidates_.clear();
+    for (const SystemIndex system : selected_system_ids_.equidistant()) {
+      placement_candidates_.push_back({system, placement_flags(system), true});
+    }
+    for (const SystemIndex system : selected_system_ids_.in_slice()) {
+      placement_candidates_.push_back({system, placement_flags(system), false});
+    }
+    // Place the most constrained systems first. Systems that are not subject
+    // to any placement rule go last.
+    std::stable_sort(
+        placement_candidates_.begin(), placement_candidates_.end(),
+        [](const PlacementCandidate& candidate_1,
+           const PlacementCandidate& candidate_2) -> bool {
+          return std::bitset<8>(candidate_1.flags).count()
+                 > std::bitset<8>(candidate_2.flags).count();
+        });
+    number_of_constrained_placement_candidates_ = 0;
+    while (number_of_constrained_placement_candidates_
+               < placement_candidates_.size()
+           && placement_candidates_[number_of_constrained_placement_candidates_]
+                      .flags
+                  != 0) {
+      ++number_of_constrained_placement_candidates_;
+    }
+    placed_shuffled_indices_.resize(
+        number_of_constrained_placement_candidates_);
+  }
+
+  static uint8_t placement_flags(const SystemIndex system) noexcept {
+    return Catalog.flags(system)
+           & (placement_anomaly_ | placement_alpha_wormhole_
+              | placement_beta_wormhole_ | placement_wormhole_
+              | placement_supernova_);
+  }
+
+  /// \brief Recursively places the constrained candidates starting at the
+  /// given candidate. Returns true once every constrained candidate has been
+  /// placed.
+  bool place_constrained_candidates(
+      const std::size_t candidate_index) noexcept {
+    if (candidate_index == number_of_constrained_placement_candidates_) {
+      return true;
+    }
+    const PlacementCandidate& candidate{placement_candidates_[candidate_index]};
+    const std::vector<uint8_t>& shuffled_indices{
+        candidate.is_equidistant ? shuffled_equidistant_placement_indices_ :
+                                   shuffled_in_slice_placement_indices_};
+    // Consecutive candidates with the same placement rule properties are
+    // interchangeable, so only place them in increasing position order.
+    std::size_t start{0};
+    if (candidate_index > 0) {
+      const PlacementCandidate& previous{
+          placement_candidates_[candidate_index - 1]};
+      if (previous.flags == candidate.flags
+          && previous.is_equidistant == candidate.is_equidistant
+          && previous.slice_player == candidate.slice_player) {
+        start = placed_shuffled_indices_[candidate_index - 1] + 1;
+      }
+    }
+    for (std::size_t shuffled_index = start;
+         shuffled_index < shuffled_indices.size(); ++shuffled_index) {
+      const uint8_t index{shuffled_indices[shuffled_index]};
+      if (placed_systems_[index] != NoSystemIndex
+          || (candidate.slice_player != 0
+              && placement_slice_players_[index] != candidate.slice_player)) {
+        continue;
+      }
+      if (++number_of_placement_steps_ > maximum_number_of_placement_steps_) {
+        return false;
+      }
+      if (!can_place(index, candidate.flags)) {
+        continue;
+      }
+      placed_shuffled_indices_[candidate_index] = shuffled_index;
+      placed_systems_[index] = candidate.system;
+      placed_flags_[index] = candidate.flags;
+      update_placement_counts(index, candidate.flags, 1);
+      if (place_constrained_candidates(candidate_index + 1)) {
+        return true;
+      }
+      update_placement_counts(index, candidate.flags, -1);
+      placed_systems_[index] = NoSystemIndex;
+      placed_flags_[index] = 0;
+      if (number_of_placement_steps_ > maximum_number_of_placement_steps_) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  /// \brief Systems that contain no anomalies and no wormholes can go anywhere,
+  /// or anywhere in their slice if they are restricted to a slice.
+  void place_unconstrained_candidates() noexcept {
+    std::size_t equidistant_shuffled_index{0};
+    // Indexed by slice player, or 0 for in-slice systems that can go to any
+    // slice.
+    std::array<std::size_t, 9> in_slice_shuffled_indices{};
+    for (std::size_t candidate_index =
+             number_of_constrained_placement_candidates_;
+         candidate_index < placement_candidates_.size(); ++candidate_index) {
+      const PlacementCandidate& candidate{
+          placement_candidates_[candidate_index]};
+      const std::vector<uint8_t>& shuffled_indices{
+          candidate.is_equidistant ? shuffled_equidistant_placement_indices_ :
+                                     shuffled_in_slice_placement_indices_};
+      std::size_t& shuffled_index{
+          candidate.is_equidistant ?
+              equidistant_shuffled_index :
+              in_slice_shuffled_indices[candidate.slice_player]};
+      while (placed_systems_[shuffled_indices[shuffled_index]] != NoSystemIndex
+             || (candidate.slice_player != 0
+                 && placement_slice_players_[shuffled_indices[shuffled_index]]
+                        != candidate.slice_player)) {
+        ++shuffled_index;
+      }
+      placed_systems_[shuffled_indices[shuffled_index]] = candidate.system;
+    }
+  }
+
+  /// \brief Returns true if a system with the given placement rule properties
+  /// can be placed at the given placement position without breaking a rule
+  /// with respect to the systems already placed.
+  bool can_place(const std::size_t index, const uint8_t flags) const noexcept {
+    const uint8_t adjacency_flags{static_cast<uint8_t>(
+        flags
+        & (placement_anomaly_ | placement_alpha_wormhole_
+           | placement_beta_wormhole_))};
+    for (const uint8_t neighbor_index : placement_neighbors_[index]) {
+      if ((placed_flags_[neighbor_index] & adjacency_flags) != 0) {
+        return false;
+      }
+    }
+    if ((flags & placement_wormhole_) != 0) {
+      for (const Player player : placement_home_adjacent_players_[index]) {
+        if (placed_wormholes_adjacent_to_homes_[static_cast<uint8_t>(player)]
+            >= 1) {
+          return false;
+        }
+      }
+    }
+    if ((flags & placement_supernova_) != 0) {
+      Bitboard supernovas{placed_supernova_bitboard_};
+      supernovas.insert(placement_ordinals_[index]);
+      if (!pathways_to_mecatol_rex_are_clear(supernovas)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Adds (increment of 1) or removes (increment of -1) a system with
+  /// the given placement rule properties at the given placement position.
+  void update_placement_counts(const std::size_t index, const uint8_t flags,
+                               const int8_t increment) noexcept {
+    if ((flags & placement_wormhole_) != 0) {
+      for (const Player player : placement_home_adjacent_players_[index]) {
+        placed_wormholes_adjacent_to_homes_[static_cast<uint8_t>(player)] +=
+            increment;
+      }
+    }
+    if ((flags & placement_supernova_) != 0) {
+      placed_supernova_bitboard_.assign(
+          placement_ordinals_[index], increment > 0);
+    }
   }
 
   struct NeighborsContents {
     NeighborsContents(
         const std::set<Position>& neighbor_positions,
-        const std::unordered_map<Position, Tile>& positions_to_tiles) noexcept {
+        const TileArray& positions_to_tiles) noexcept {
       for (const Position& neighbor_position : neighbor_positions) {
-        const std::unordered_map<Position, Tile>::const_iterator
-            neighbor_position_and_tile{
-                positions_to_tiles.find(neighbor_position)};
-        if (neighbor_position_and_tile->second
-                .is_planetary_anomaly_wormhole_or_empty()) {
-          const std::unordered_set<System>::const_iterator neighbor_system{
-              Systems.find({neighbor_position_and_tile->second.system_id()})};
-          if (!one_or_more_anomalies
-              && neighbor_system->contains_one_or_more_anomalies()) {
+        const Tile* neighbor_tile{positions_to_tiles.find(neighbor_position)};
+        if (neighbor_tile->is_planetary_anomaly_wormhole_or_empty()) {
+          const uint8_t neighbor_flags{Catalog.flags(
+              neighbor_tile->system_index())};
+          if ((neighbor_flags & SystemContainsAnomaly) != 0) {
             one_or_more_anomalies = true;
           }
-          if (!one_or_more_alpha_wormholes
-              && neighbor_system->contains(Wormhole::Alpha)) {
+          if ((neighbor_flags & SystemContainsAlphaWormhole) != 0) {
             one_or_more_alpha_wormholes = true;
           }
-          if (!one_or_more_beta_wormholes
-              && neighbor_system->contains(Wormhole::Beta)) {
+          if ((neighbor_flags & SystemContainsBetaWormhole) != 0) {
             one_or_more_beta_wormholes = true;
           }
         }
@@ -268,61 +1530,68 @@ private:
     bool one_or_more_beta_wormholes{false};
   };
 
+  template <bool Instrumented = false>
   bool iteration_is_valid() const noexcept {
-    return !contains_adjacent_anomalies_or_wormholes()
-           && pathways_to_mecatol_rex_are_clear()
-           && players_do_not_have_too_many_wormholes_adjacent_to_their_homes()
-           && players_have_enough_planets()
-           && players_have_enough_useful_resources_and_useful_influence();
+    return passes<Instrumented>(
+               ValidityCheck::AdjacentAnomaliesOrWormholes,
+               [this]() { return !contains_adjacent_anomalies_or_wormholes(); })
+           && passes<Instrumented>(
+               ValidityCheck::PathwaysToMecatolRex,
+               [this]() { return pathways_to_mecatol_rex_are_clear(); })
+           && passes<Instrumented>(
+               ValidityCheck::WormholesAdjacentToHomes,
+               [this]() {
+                 return players_do_not_have_too_many_wormholes_adjacent_to_their_homes();
+               })
+           && passes<Instrumented>(
+               ValidityCheck::EnoughPlanets,
+               [this]() { return players_have_enough_planets(); })
+           && passes<Instrumented>(
+               ValidityCheck::EnoughUsefulResourcesAndUsefulInfluence,
+               [this]() {
+                 return players_have_enough_useful_resources_and_useful_influence();
+               });
+  }
+
+  /// \brief Number of validity checks that the board fails. Unlike
+  /// iteration_is_valid(), evaluates every check.
+  template <bool Instrumented = false>
+  uint8_t number_of_failed_validity_checks() const noexcept {
+    const std::array<bool, 5> passed{
+        passes<Instrumented>(
+            ValidityCheck::AdjacentAnomaliesOrWormholes,
+            [this]() { return !contains_adjacent_anomalies_or_wormholes(); }),
+        passes<Instrumented>(
+            ValidityCheck::PathwaysToMecatolRex,
+            [this]() { return pathways_to_mecatol_rex_are_clear(); }),
+        passes<Instrumented>(
+            ValidityCheck::WormholesAdjacentToHomes,
+            [this]() {
+              return players_do_not_have_too_many_wormholes_adjacent_to_their_homes();
+            }),
+        passes<Instrumented>(
+            ValidityCheck::EnoughPlanets,
+            [this]() { return players_have_enough_planets(); }),
+        passes<Instrumented>(
+            ValidityCheck::EnoughUsefulResourcesAndUsefulInfluence,
+            [this]() {
+              return players_have_enough_useful_resources_and_useful_influence();
+            }),
+    };
+    return static_cast<uint8_t>(
+        std::count(passed.cbegin(), passed.cend(), false));
   }
 
   /// \brief As per the game rules, adjacent systems cannot contain anomalies or
   /// wormholes of the same type.
   bool contains_adjacent_anomalies_or_wormholes() const noexcept {
-    std::unordered_set<Position> checked;
-    for (std::unordered_map<Position, Tile>::const_iterator position_and_tile =
-             positions_to_tiles_.cbegin();
-         position_and_tile != positions_to_tiles_.cend(); ++position_and_tile) {
-      if (position_and_tile->second.is_planetary_anomaly_wormhole_or_empty()
-          && checked.find(position_and_tile->first) == checked.cend()) {
-        // This tile is of the relevant category and has not yet been checked.
-        checked.insert(position_and_tile->first);
-        const std::unordered_set<System>::const_iterator system{
-            Systems.find({position_and_tile->second.system_id()})};
-        const bool contains_anomaly{system->contains_one_or_more_anomalies()};
-        const bool contains_alpha_wormhole{system->contains(Wormhole::Alpha)};
-        const bool contains_beta_wormhole{system->contains(Wormhole::Beta)};
-        if (contains_anomaly || contains_alpha_wormhole
-            || contains_beta_wormhole) {
-          // This tile contains one or more anomalies or wormholes.
-          const std::unordered_map<Position, std::set<Position>>::const_iterator
-              position_and_neighbors{neighbors_.find(position_and_tile->first)};
-          if (position_and_neighbors != neighbors_.cend()) {
-            for (const Position& neighbor_position :
-                 position_and_neighbors->second) {
-              const std::unordered_map<Position, Tile>::const_iterator
-                  neighbor_position_and_tile{
-                      positions_to_tiles_.find(neighbor_position)};
-              if (neighbor_position_and_tile != positions_to_tiles_.cend()
-                  && neighbor_position_and_tile->second
-                         .is_planetary_anomaly_wormhole_or_empty()
-                  && checked.find(neighbor_position) == checked.cend()) {
-                // This neighbor is of the relevant category and has not yet
-                // been checked.
-                const std::unordered_set<System>::const_iterator
-                    neighbor_system{Systems.find(
-                        {neighbor_position_and_tile->second.system_id()})};
-                if ((contains_anomaly
-                     && neighbor_system->contains_one_or_more_anomalies())
-                    || (contains_alpha_wormhole
-                        && neighbor_system->contains(Wormhole::Alpha))
-                    || (contains_beta_wormhole
-                        && neighbor_system->contains(Wormhole::Beta))) {
-                  return true;
-                }
-              }
-            }
-          }
+    for (const Bitboard& bitboard :
+         {anomaly_bitboard_, alpha_wormhole_bitboard_,
+          beta_wormhole_bitboard_}) {
+      Bitboard remaining{bitboard};
+      while (!remaining.empty()) {
+        if (!(neighbor_bitboards_[remaining.pop_front()] & bitboard).empty()) {
+          return true;
         }
       }
     }
@@ -333,74 +1602,49 @@ private:
   /// that is devoid of supernovas. A supernova along the pathway to Mecatol Rex
   /// lengthens the pathway, making it undesirable.
   bool pathways_to_mecatol_rex_are_clear() const noexcept {
-    bool each_player_has_at_least_one_usable_pathway{true};
-    for (const std::pair<const Player, std::vector<Pathway>>&
-             player_and_mecatol_rex_pathways :
-         players_to_mecatol_rex_pathways_) {
-      if (!player_and_mecatol_rex_pathways.second.empty()) {
-        bool player_has_no_usable_pathways{true};
-        for (const Pathway& pathway : player_and_mecatol_rex_pathways.second) {
-          bool pathway_is_usable{true};
-          for (const Position& position : pathway) {
-            const std::unordered_map<Position, Tile>::const_iterator
-                position_and_tile{positions_to_tiles_.find(position)};
-            const std::unordered_set<System>::const_iterator system{
-                Systems.find({position_and_tile->second.system_id()})};
-            if (system->contains(Anomaly::Supernova)) {
-              pathway_is_usable = false;
-              break;
-            }
-          }
-          if (pathway_is_usable) {
-            player_has_no_usable_pathways = false;
-            break;
-          }
-        }
-        if (player_has_no_usable_pathways) {
-          each_player_has_at_least_one_usable_pathway = false;
-          break;
-        }
-      }
+    if (supernova_bitboard_.empty()) {
+      return true;
     }
-    return each_player_has_at_least_one_usable_pathway;
+    return pathways_to_mecatol_rex_are_clear(supernova_bitboard_);
   }
 
-  bool players_do_not_have_too_many_wormholes_adjacent_to_their_homes()
-      const noexcept {
-    std::map<Player, int8_t> players_to_number_of_wormholes_adjacent_to_home;
-    for (const Player& player : players_) {
-      players_to_number_of_wormholes_adjacent_to_home.emplace(player, 0);
-    }
-    for (const std::pair<const Player, std::set<Position>>&
-             player_and_forward_positions : players_to_forward_positions_) {
-      for (const Position& position : player_and_forward_positions.second) {
-        const std::unordered_map<Position, Tile>::const_iterator
-            position_and_tile{positions_to_tiles_.find(position)};
-        const std::unordered_set<System>::const_iterator system{
-            Systems.find({position_and_tile->second.system_id()})};
-        if (system->contains_one_or_more_wormholes()) {
-          ++(players_to_number_of_wormholes_adjacent_to_home
-                 [player_and_forward_positions.first]);
+  /// \brief Returns true if each player has at least one pathway to Mecatol
+  /// Rex that avoids the given supernovas. Rather than checking each pathway,
+  /// this finds the positions from which Mecatol Rex can be reached without
+  /// crossing a supernova, from Mecatol Rex outward, so the cost is linear in
+  /// the number of positions along the pathways.
+  bool pathways_to_mecatol_rex_are_clear(
+      const Bitboard& supernovas) const noexcept {
+    Bitboard clear;
+    for (std::size_t distance = 0; distance < pathway_layer_bitboards_.size();
+         ++distance) {
+      Bitboard remaining{pathway_layer_bitboards_[distance]};
+      while (!remaining.empty()) {
+        const uint8_t ordinal{remaining.pop_front()};
+        if (!supernovas.contains(ordinal)
+            && (distance == 0
+                || !(nearer_neighbor_bitboards_[ordinal] & clear).empty())) {
+          clear.insert(ordinal);
         }
       }
     }
-    for (const std::pair<const Player, std::set<Position>>&
-             player_and_lateral_positions : players_to_lateral_positions_) {
-      for (const Position& position : player_and_lateral_positions.second) {
-        const std::unordered_map<Position, Tile>::const_iterator
-            position_and_tile{positions_to_tiles_.find(position)};
-        const std::unordered_set<System>::const_iterator system{
-            Systems.find({position_and_tile->second.system_id()})};
-        if (system->contains_one_or_more_wormholes()) {
-          ++(players_to_number_of_wormholes_adjacent_to_home
-                 [player_and_lateral_positions.first]);
-        }
+    for (const Player player : players_) {
+      const Bitboard& starts{
+          pathway_start_bitboards_[static_cast<uint8_t>(player)]};
+      if (!starts.empty() && (starts & clear).empty()) {
+        return false;
       }
     }
-    for (const std::pair<const Player, int8_t>&
-             player_and_number_of_wormholes_adjacent_to_home :
-         players_to_number_of_wormholes_adjacent_to_home) {
-      if (player_and_number_of_wormholes_adjacent_to_home.second > 1) {
+    return true;
+  }
+
+  bool players_do_not_have_too_many_wormholes_adjacent_to_their_homes()
+      const noexcept {
+    for (const Player player : players_) {
+      const uint8_t player_index{static_cast<uint8_t>(player)};
+      if ((forward_bitboards_[player_index] & wormhole_bitboard_).size()
+              + (lateral_bitboards_[player_index] & wormhole_bitboard_).size()
+          > 1) {
         return false;
       }
     }
@@ -424,36 +1668,20 @@ private:
   /// Each player must have a minimum number of planets per system, including
   /// in-slice and equidistant positions.
   bool players_have_enough_planets() const noexcept {
-    std::map<Player, float> players_to_effective_number_of_systems;
-    std::map<Player, float> players_to_effective_number_of_planets;
-    for (const Player player : players_) {
-      players_to_effective_number_of_systems.emplace(player, 0.0f);
-      players_to_effective_number_of_planets.emplace(player, 0.0f);
-    }
-    for (const std::pair<const Position, std::set<Player>>&
-             position_and_relevant_players : positions_to_relevant_players_) {
-      const std::unordered_map<Position, Tile>::const_iterator
-          position_and_tile{
-              positions_to_tiles_.find(position_and_relevant_players.first)};
-      const std::unordered_set<System>::const_iterator system{
-          Systems.find({position_and_tile->second.system_id()})};
-      // Exclude the Mecatol Rex system, hyperlanes, and other irrelevant system
-      // categories.
-      if (system->category() == SystemCategory::Planetary
-          || system->category() == SystemCategory::AnomalyWormholeEmpty) {
-        const float factor{number_of_relevant_players_factor(
-            position_and_relevant_players.second.size())};
-        for (const Player player : position_and_relevant_players.second) {
-          players_to_effective_number_of_systems[player] += factor;
-          players_to_effective_number_of_planets[player] +=
-              static_cast<float>(system->planets().size()) * factor;
-        }
+    std::array<float, 64> systems{};
+    std::array<float, 64> planets{};
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      const SystemIndex system{
+          positions_to_tiles_.find(placement_ordinals_[index])->system_index()};
+      if (is_counted_by_validity_checks(system)) {
+        systems[index] = 1.0f;
+        planets[index] = static_cast<float>(Catalog.number_of_planets(system));
       }
     }
     for (const Player player : players_) {
       const float effective_planets_to_positions_ratio{
-          players_to_effective_number_of_planets[player]
-          / players_to_effective_number_of_systems[player]};
+          player_dot_product(relevant_player_weights_, player, planets)
+          / player_dot_product(relevant_player_weights_, player, systems)};
       if (effective_planets_to_positions_ratio < 0.76f) {
         return false;
       }
@@ -467,48 +1695,30 @@ private:
   /// system, including in-slice and equidistant positions.
   bool
   players_have_enough_useful_resources_and_useful_influence() const noexcept {
-    std::map<Player, float> players_to_number_of_systems;
-    std::map<Player, float> players_to_useful_resources;
-    std::map<Player, float> players_to_useful_influence;
-    for (const Player& player : players_) {
-      players_to_number_of_systems.emplace(player, 0.0f);
-      players_to_useful_resources.emplace(player, 0.0f);
-      players_to_useful_influence.emplace(player, 0.0f);
-    }
-    for (const std::pair<const Position, std::set<Player>>&
-             position_and_relevant_players : positions_to_relevant_players_) {
-      const std::unordered_map<Position, Tile>::const_iterator
-          position_and_tile{
-              positions_to_tiles_.find(position_and_relevant_players.first)};
-      const std::unordered_set<System>::const_iterator system{
-          Systems.find({position_and_tile->second.system_id()})};
-      // Exclude the Mecatol Rex system, hyperlanes, and other irrelevant system
-      // categories.
-      if (system->category() == SystemCategory::Planetary
-          || system->category() == SystemCategory::AnomalyWormholeEmpty) {
-        const float factor{number_of_relevant_players_factor(
-            position_and_relevant_players.second.size())};
-        for (const Player& player : position_and_relevant_players.second) {
-          players_to_number_of_systems[player] += factor;
-          for (const Planet& planet : system->planets()) {
-            players_to_useful_resources[player] +=
-                planet.useful_resources() * factor;
-            players_to_useful_influence[player] +=
-                planet.useful_influence() * factor;
-          }
-        }
+    std::array<float, 64> systems{};
+    std::array<float, 64> useful_resources{};
+    std::array<float, 64> useful_influence{};
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      const SystemIndex system{
+          positions_to_tiles_.find(placement_ordinals_[index])->system_index()};
+      if (is_counted_by_validity_checks(system)) {
+        systems[index] = 1.0f;
+        useful_resources[index] = Catalog.useful_resources(system);
+        useful_influence[index] = Catalog.useful_influence(system);
       }
     }
     for (const Player player : players_) {
+      const float number_of_systems{
+          player_dot_product(relevant_player_weights_, player, systems)};
       const float useful_resources_per_system{
-          players_to_useful_resources[player]
-          / players_to_number_of_systems[player]};
+          player_dot_product(relevant_player_weights_, player, useful_resources)
+          / number_of_systems};
       if (useful_resources_per_system < 0.52f) {
         return false;
       }
       const float useful_influence_per_system{
-          players_to_useful_influence[player]
-          / players_to_number_of_systems[player]};
+          player_dot_product(relevant_player_weights_, player, useful_influence)
+          / number_of_systems};
       if (useful_influence_per_system < 0.58f) {
         return false;
       }
@@ -516,13 +1726,33 @@ private:
     return true;
   }
 
+  /// \brief Returns true if the planets, resources, and influence checks count
+  /// the given system. This excludes the Mecatol Rex system, hyperlanes, and
+  /// other irrelevant system categories.
+  static bool is_counted_by_validity_checks(const SystemIndex system) noexcept {
+    return system != NoSystemIndex
+           && (Catalog.category(system) == SystemCategory::Planetary
+               || Catalog.category(system)
+                      == SystemCategory::AnomalyWormholeEmpty);
+  }
+
+  template <bool Instrumented = false>
   void calculate_player_scores() noexcept {
     reset_scores();
-    add_base_system_scores();
-    add_preferred_expansion_position_scores();
-    add_alternate_expansion_position_scores();
-    add_mecatol_rex_pathway_scores();
-    add_number_of_systems_containing_planets_adjacent_to_home_scores();
+    evaluate<Instrumented>(
+        ScoringTerm::BaseSystems, [this]() { add_base_system_scores(); });
+    evaluate<Instrumented>(ScoringTerm::PreferredExpansionPositions, [this]() {
+      add_preferred_expansion_position_scores();
+    });
+    evaluate<Instrumented>(ScoringTerm::AlternateExpansionPositions, [this]() {
+      add_alternate_expansion_position_scores();
+    });
+    evaluate<Instrumented>(ScoringTerm::MecatolRexPathways,
+                           [this]() { add_mecatol_rex_pathway_scores(); });
+    evaluate<Instrumented>(
+        ScoringTerm::SystemsContainingPlanetsAdjacentToHome, [this]() {
+          add_number_of_systems_containing_planets_adjacent_to_home_scores();
+        });
   }
 
   void reset_scores() noexcept {
@@ -550,37 +1780,22 @@ private:
   /// a system is equidistant, each relevant player gets a fraction of its
   /// score.
   void add_base_system_scores() noexcept {
-    for (const std::pair<const Position, Tile>& position_and_tile :
-         positions_to_tiles_) {
-      const std::unordered_map<Position, std::map<Player, Distance>>::
-          const_iterator position_and_players_home_distances{
-              positions_to_players_home_distances_.find(
-                  position_and_tile.first)};
-      if (position_and_tile.second.is_planetary_anomaly_wormhole_or_empty()
-          && position_and_players_home_distances
-                 != positions_to_players_home_distances_.cend()) {
-        const std::unordered_map<Position, std::set<Player>>::const_iterator
-            position_to_relevant_players{
-                positions_to_relevant_players_.find(position_and_tile.first)};
-        if (position_to_relevant_players
-            != positions_to_relevant_players_.cend()) {
-          const float score_per_player{
-              Systems.find({position_and_tile.second.system_id()})->score()
-              * number_of_relevant_players_factor(
-                  position_to_relevant_players->second.size())};
-          for (const Player& player : position_to_relevant_players->second) {
-            const std::map<Player, Distance>::const_iterator
-                player_and_distance{
-                    position_and_players_home_distances->second.find(player)};
-            if (player_and_distance
-                != position_and_players_home_distances->second.cend()) {
-              player_scores_[player] +=
-                  score_per_player
-                  * distance_factor(player_and_distance->second);
-            }
-          }
-        }
+    const std::size_t number_of_positions{placement_positions_.size()};
+    for (std::size_t index = 0; index < number_of_positions; ++index) {
+      placement_scores_[index] = Catalog.score(
+          positions_to_tiles_.find(placement_ordinals_[index])->system_index());
+    }
+    // Multiply the weight matrix by the vector of system scores. Each row is a
+    // plain dot product over contiguous arrays.
+    const float* weights{base_score_weights_.data()};
+    const float* scores{placement_scores_.data()};
+    for (const Player player : players_) {
+      float score{0.0f};
+      for (std::size_t index = 0; index < number_of_positions; ++index) {
+        score += weights[index] * scores[index];
       }
+      player_scores_[player] += score;
+      weights += number_of_positions;
     }
   }
 
@@ -596,12 +1811,9 @@ private:
          players_to_preferred_expansion_positions_) {
       for (const Position& position :
            player_and_preferred_expansion_positions.second) {
-        const std::unordered_map<Position, Tile>::const_iterator
-            position_and_tile{positions_to_tiles_.find(position)};
-        const std::unordered_set<System>::const_iterator system{
-            Systems.find({position_and_tile->second.system_id()})};
-        const float preferred_expansion_position_score{
-            system->expansion_score()};
+        const Tile* tile{positions_to_tiles_.find(position)};
+        const float preferred_expansion_position_score{Catalog.expansion_score(
+            tile->system_index())};
         if (preferred_expansion_position_score
             > players_and_best_expansion_scores
                 [player_and_preferred_expansion_positions.first]) {
@@ -616,12 +1828,11 @@ private:
          players_to_alternate_expansion_positions_) {
       for (const Position& position :
            player_and_alternate_expansion_positions.second) {
-        const std::unordered_map<Position, Tile>::const_iterator
-            position_and_tile{positions_to_tiles_.find(position)};
-        const std::unordered_set<System>::const_iterator system{
-            Systems.find({position_and_tile->second.system_id()})};
+        const Tile* tile{positions_to_tiles_.find(position)};
         const float alternate_expansion_position_score{
-            0.5f * system->expansion_score()};
+            0.5f
+            * Catalog.expansion_score(
+                tile->system_index())};
         if (alternate_expansion_position_score
             > players_and_best_expansion_scores
                 [player_and_alternate_expansion_positions.first]) {
@@ -641,89 +1852,97 @@ private:
   /// \brief If a player can construct a space dock on their preferred expansion
   /// positions, the score is increased.
   void add_preferred_expansion_position_scores() noexcept {
-    for (const std::pair<const Player, std::set<Position>>&
-             player_and_preferred_expansion_positions :
-         players_to_preferred_expansion_positions_) {
-      if (!player_and_preferred_expansion_positions.second.empty()) {
-        float average_preferred_expansion_position_score{0.0f};
-        for (const Position& position :
-             player_and_preferred_expansion_positions.second) {
-          const std::unordered_map<Position, Tile>::const_iterator
-              position_and_tile{positions_to_tiles_.find(position)};
-          const std::unordered_set<System>::const_iterator system{
-              Systems.find({position_and_tile->second.system_id()})};
-          const float preferred_expansion_position_score{
-              system->expansion_score()};
-          average_preferred_expansion_position_score +=
-              preferred_expansion_position_score;
-        }
-        average_preferred_expansion_position_score /= static_cast<float>(
-            player_and_preferred_expansion_positions.second.size());
-        player_scores_[player_and_preferred_expansion_positions.first] +=
-            average_preferred_expansion_position_score;
-      }
+    const std::array<float, 64> expansion_scores{placement_expansion_scores()};
+    for (const Player player : players_) {
+      player_scores_[player] += player_dot_product(
+          preferred_expansion_weights_, player, expansion_scores);
     }
   }
 
   /// \brief If a player can construct a space dock on their alternate expansion
   /// positions, the score is increased.
   void add_alternate_expansion_position_scores() noexcept {
-    for (const std::pair<const Player, std::set<Position>>&
-             player_and_alternate_expansion_positions :
-         players_to_alternate_expansion_positions_) {
-      if (!player_and_alternate_expansion_positions.second.empty()) {
-        float average_alternate_expansion_position_score{0.0f};
-        for (const Position& position :
-             player_and_alternate_expansion_positions.second) {
-          const std::unordered_map<Position, Tile>::const_iterator
-              position_and_tile{positions_to_tiles_.find(position)};
-          const std::unordered_set<System>::const_iterator system{
-              Systems.find({position_and_tile->second.system_id()})};
-          const float alternate_expansion_position_score{
-              0.5f * system->expansion_score()};
-          average_alternate_expansion_position_score +=
-              alternate_expansion_position_score;
-        }
-        average_alternate_expansion_position_score /= static_cast<float>(
-            player_and_alternate_expansion_positions.second.size());
-        player_scores_[player_and_alternate_expansion_positions.first] +=
-            average_alternate_expansion_position_score;
-      }
+    const std::array<float, 64> expansion_scores{placement_expansion_scores()};
+    for (const Player player : players_) {
+      player_scores_[player] += player_dot_product(
+          alternate_expansion_weights_, player, expansion_scores);
     }
   }
 
+  /// \brief Expansion score of the system on each placement position, indexed
+  /// by placement index.
+  std::array<float, 64> placement_expansion_scores() const noexcept {
+    std::array<float, 64> expansion_scores{};
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      expansion_scores[index] = Catalog.expansion_score(
+          positions_to_tiles_.find(placement_ordinals_[index])->system_index());
+    }
+    return expansion_scores;
+  }
+
   /// \brief If a player does not have a clear pathway to Mecatol Rex, the score
   /// is penalized.
   void add_mecatol_rex_pathway_scores() noexcept {
-    for (const std::pair<const Player, std::vector<Pathway>>&
-             player_and_mecatol_rex_pathways :
-         players_to_mecatol_rex_pathways_) {
-      if (!player_and_mecatol_rex_pathways.second.empty()) {
-        float best_pathway_score{std::numeric_limits<float>::lowest()};
-        for (const Pathway& pathway : player_and_mecatol_rex_pathways.second) {
-          float pathway_score{0.0f};
-          for (const Position& position : pathway) {
-            const std::unordered_map<Position, Tile>::const_iterator
-                position_and_tile{positions_to_tiles_.find(position)};
-            const std::unordered_set<System>::const_iterator system{
-                Systems.find({position_and_tile->second.system_id()})};
-            if (system->contains(Anomaly::GravityRift)) {
-              // A gravity rift along the pathway to Mecatol Rex is undesirable.
-              pathway_score += -3.0f;
-            }
-            if (system->contains(Anomaly::Nebula)) {
-              // A nebula along the pathway to Mecatol Rex is undesirable.
-              pathway_score += -3.0f;
-            }
-          }
-          if (pathway_score > best_pathway_score) {
-            best_pathway_score = pathway_score;
+    std::array<float, 64> position_scores{};
+    for (const Bitboard& layer : pathway_layer_bitboards_) {
+      Bitboard remaining{layer};
+      while (!remaining.empty()) {
+        const uint8_t ordinal{remaining.pop_front()};
+        // A gravity rift or a nebula along the pathway to Mecatol Rex is
+        // undesirable.
+        position_scores[ordinal] = pathway_score(
+            positions_to_tiles_.find(ordinal)->system_index());
+      }
+    }
+    const std::array<float, 64> best_scores{
+        best_scores_to_mecatol_rex(position_scores)};
+    for (const Player player : players_) {
+      if (!pathway_start_bitboards_[static_cast<uint8_t>(player)].empty()) {
+        player_scores_[player] += best_pathway_score(player, best_scores);
+      }
+    }
+  }
+
+  /// \brief Best score of a pathway to Mecatol Rex from each position along
+  /// the pathways, indexed by position ordinal, given the score of each
+  /// position. This is computed by dynamic programming from Mecatol Rex
+  /// outward: the best score from a position is its own score plus the best
+  /// score from its nearer neighbors.
+  std::array<float, 64> best_scores_to_mecatol_rex(
+      const std::array<float, 64>& position_scores) const noexcept {
+    std::array<float, 64> best_scores{};
+    for (std::size_t distance = 0; distance < pathway_layer_bitboards_.size();
+         ++distance) {
+      Bitboard remaining{pathway_layer_bitboards_[distance]};
+      while (!remaining.empty()) {
+        const uint8_t ordinal{remaining.pop_front()};
+        float best_next_score{0.0f};
+        if (distance > 0) {
+          best_next_score = std::numeric_limits<float>::lowest();
+          Bitboard nearer{nearer_neighbor_bitboards_[ordinal]};
+          while (!nearer.empty()) {
+            best_next_score =
+                std::max(best_next_score, best_scores[nearer.pop_front()]);
           }
         }
-        player_scores_[player_and_mecatol_rex_pathways.first] +=
-            best_pathway_score;
+        best_scores[ordinal] = position_scores[ordinal] + best_next_score;
       }
     }
+    return best_scores;
+  }
+
+  /// \brief Score of the best pathway to Mecatol Rex of a player, given the
+  /// best score from each position.
+  float best_pathway_score(
+      const Player player,
+      const std::array<float, 64>& best_scores) const noexcept {
+    float best_pathway_score_{std::numeric_limits<float>::lowest()};
+    Bitboard starts{pathway_start_bitboards_[static_cast<uint8_t>(player)]};
+    while (!starts.empty()) {
+      best_pathway_score_ =
+          std::max(best_pathway_score_, best_scores[starts.pop_front()]);
+    }
+    return best_pathway_score_;
   }
 
   void
@@ -731,41 +1950,137 @@ private:
     // Check the forward systems and the lateral systems.
     // Ideally, a player wants two systems that each contain one or more planets
     // adjacent to their home.
-    for (const Player& player : players_) {
-      uint8_t number_of_systems_containing_planets{0};
-      const std::map<Player, std::set<Position>>::const_iterator
-          player_and_forward_positions{
-              players_to_forward_positions_.find(player)};
-      if (player_and_forward_positions
-          != players_to_forward_positions_.cend()) {
-        for (const Position& position : player_and_forward_positions->second) {
-          const std::unordered_map<Position, Tile>::const_iterator
-              position_and_tile{positions_to_tiles_.find(position)};
-          const std::unordered_set<System>::const_iterator system{
-              Systems.find({position_and_tile->second.system_id()})};
-          if (!system->planets().empty()) {
-            ++number_of_systems_containing_planets;
-          }
-        }
+    std::array<float, 64> contains_planets{};
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      if ((Catalog.flags(positions_to_tiles_.find(placement_ordinals_[index])
+                             ->system_index())
+           & SystemContainsPlanets)
+          != 0) {
+        contains_planets[index] = 1.0f;
+      }
+    }
+    for (const Player player : players_) {
+      player_scores_[player] +=
+          2.0f
+          * (player_dot_product(home_adjacency_weights_, player,
+                                contains_planets)
+             - 2.0f);
+    }
+  }
+
+  /// \brief Score of a system along a pathway to Mecatol Rex. Matches
+  /// add_mecatol_rex_pathway_scores().
+  static float pathway_score(const SystemIndex system) noexcept {
+    if (system == NoSystemIndex) {
+      return 0.0f;
+    }
+    float score{0.0f};
+    if ((Catalog.flags(system) & SystemContainsGravityRift) != 0) {
+      score += -3.0f;
+    }
+    if ((Catalog.flags(system) & SystemContainsNebula) != 0) {
+      score += -3.0f;
+    }
+    return score;
+  }
+
+  /// \brief Calculates the player scores from scratch and initializes the
+  /// state of the incremental scorer from the systems currently on the tiles.
+  /// Call this before swap_system_ids_and_update_player_scores().
+  void initialize_incremental_player_scores() noexcept {
+    calculate_player_scores();
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      scored_systems_[index] =
+          positions_to_tiles_.find(placement_positions_[index])
+              ->system_index();
+    }
+    pathway_position_scores_.fill(0.0f);
+    for (const Bitboard& layer : pathway_layer_bitboards_) {
+      Bitboard remaining{layer};
+      while (!remaining.empty()) {
+        const uint8_t ordinal{remaining.pop_front()};
+        pathway_position_scores_[ordinal] = pathway_score(
+            positions_to_tiles_.find(ordinal)->system_index());
       }
-      const std::map<Player, std::set<Position>>::const_iterator
-          player_and_lateral_positions{
-              players_to_lateral_positions_.find(player)};
-      if (player_and_lateral_positions
-          != players_to_lateral_positions_.cend()) {
-        for (const Position& position : player_and_lateral_positions->second) {
-          const std::unordered_map<Position, Tile>::const_iterator
-              position_and_tile{positions_to_tiles_.find(position)};
-          const std::unordered_set<System>::const_iterator system{
-              Systems.find({position_and_tile->second.system_id()})};
-          if (!system->planets().empty()) {
-            ++number_of_systems_containing_planets;
+    }
+    const std::array<float, 64> best_scores{
+        best_scores_to_mecatol_rex(pathway_position_scores_)};
+    for (const Player player : players_) {
+      best_pathway_scores_[static_cast<uint8_t>(player)] =
+          best_pathway_score(player, best_scores);
+    }
+  }
+
+  /// \brief Swaps the systems of two placement positions and updates the
+  /// player scores incrementally. Only the players whose score depends on
+  /// either position are updated, and only the best pathway to Mecatol Rex of
+  /// the players whose pathways pass through either position is recalculated.
+  /// Swapping the same two positions again restores the previous state.
+  template <bool Instrumented = false>
+  void swap_system_ids_and_update_player_scores(
+      const uint8_t index_1, const uint8_t index_2) {
+    evaluate<Instrumented>(ScoringTerm::IncrementalSwap, [&]() {
+      update_player_scores_and_swap_system_ids(index_1, index_2);
+    });
+  }
+
+  /// \brief Uninstrumented body of swap_system_ids_and_update_player_scores().
+  void update_player_scores_and_swap_system_ids(
+      const uint8_t index_1, const uint8_t index_2) {
+    const SystemIndex system_1{scored_systems_[index_1]};
+    const SystemIndex system_2{scored_systems_[index_2]};
+    update_linear_player_scores(index_1, system_1, system_2);
+    update_linear_player_scores(index_2, system_2, system_1);
+    const float pathway_score_difference{
+        pathway_score(system_2) - pathway_score(system_1)};
+    const uint8_t ordinal_1{placement_ordinals_[index_1]};
+    const uint8_t ordinal_2{placement_ordinals_[index_2]};
+    if (pathway_score_difference != 0.0f) {
+      pathway_position_scores_[ordinal_1] += pathway_score_difference;
+      pathway_position_scores_[ordinal_2] -= pathway_score_difference;
+      std::array<float, 64> best_scores;
+      bool best_scores_are_calculated{false};
+      for (const Player player : players_) {
+        const uint8_t player_index{static_cast<uint8_t>(player)};
+        if (pathway_bitboards_[player_index].contains(ordinal_1)
+            || pathway_bitboards_[player_index].contains(ordinal_2)) {
+          if (!best_scores_are_calculated) {
+            best_scores = best_scores_to_mecatol_rex(pathway_position_scores_);
+            best_scores_are_calculated = true;
           }
+          const float best_pathway_score_{
+              best_pathway_score(player, best_scores)};
+          player_scores_[player] +=
+              best_pathway_score_ - best_pathway_scores_[player_index];
+          best_pathway_scores_[player_index] = best_pathway_score_;
         }
       }
-      player_scores_[player] +=
-          2.0f
-          * (static_cast<float>(number_of_systems_containing_planets) - 2.0f);
+    }
+    scored_systems_[index_1] = system_2;
+    scored_systems_[index_2] = system_1;
+    swap_system_ids(index_1, index_2);
+  }
+
+  /// \brief Updates the linear terms of the player scores when the system on a
+  /// placement position is replaced.
+  void update_linear_player_scores(const uint8_t index,
+                                   const SystemIndex old_system,
+                                   const SystemIndex new_system) noexcept {
+    const float system_difference{
+        Catalog.score(new_system) - Catalog.score(old_system)};
+    const float expansion_difference{
+        Catalog.expansion_score(new_system)
+        - Catalog.expansion_score(old_system)};
+    const float planets_difference{
+        static_cast<float>((Catalog.flags(new_system) & SystemContainsPlanets)
+                           != 0)
+        - static_cast<float>((Catalog.flags(old_system) & SystemContainsPlanets)
+                             != 0)};
+    for (const PlacementScoreWeight& weight : placement_score_weights_[index]) {
+      player_scores_[weight.player] +=
+          weight.system * system_difference
+          + weight.expansion * expansion_difference
+          + weight.planets * planets_difference;
     }
   }
 
@@ -788,6 +2103,162 @@ private:
            / average_score;
   }
 
+  /// \brief Adds the valid board currently on the tiles to the batch, along
+  /// with the iteration and the number of valid boards at which it was
+  /// generated.
+  void add_to_batch(const uint64_t number_of_iterations,
+                    const uint64_t number_of_valid_boards,
+                    const uint64_t hash) noexcept {
+    const std::size_t lane{batch_size_};
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      const SystemIndex system{
+          positions_to_tiles_.find(placement_ordinals_[index])
+              ->system_index()};
+      const std::size_t element{index * Lanes::size + lane};
+      batch_systems_[lane][index] = system;
+      batch_system_scores_[element] = Catalog.score(system);
+      batch_expansion_scores_[element] = Catalog.expansion_score(system);
+      batch_planets_[element] = static_cast<float>(
+          (Catalog.flags(system) & SystemContainsPlanets) != 0);
+      batch_pathway_scores_[element] = pathway_score(system);
+    }
+    batch_iterations_[lane] = {number_of_iterations, number_of_valid_boards};
+    batch_hashes_[lane] = hash;
+    ++batch_size_;
+  }
+
+  /// \brief Scores the boards of the batch together, then rescores exactly, in
+  /// order of generation, each board that may improve on the best board found
+  /// so far. Empties the batch. Returns true if one of these boards meets the
+  /// target score imbalance, in which case the number of iterations and the
+  /// number of valid boards are rewound to those at which it was generated.
+  /// The boards that follow it in the batch are discarded, so the outcome is
+  /// the same as if each board had been scored as soon as it was generated.
+  template <bool Instrumented>
+  bool score_batch_and_return_success(
+      const float score_imbalance_ratio_tolerance, BestBoard& best_board,
+      uint64_t& number_of_iterations, uint64_t& number_of_valid_boards) {
+    std::array<float, Lanes::size> score_imbalance_ratios;
+    evaluate<Instrumented>(ScoringTerm::Batch, [&]() {
+      score_imbalance_ratios = calculate_batch_score_imbalance_ratios();
+    });
+    const std::size_t batch_size{batch_size_};
+    batch_size_ = 0;
+    for (std::size_t lane = 0; lane < batch_size; ++lane) {
+      transposition_table_->store(
+          batch_hashes_[lane], {true, score_imbalance_ratios[lane]});
+    }
+    for (std::size_t lane = 0; lane < batch_size; ++lane) {
+      if (score_imbalance_ratios[lane] - batch_score_imbalance_ratio_margin_
+          < best_board.score_imbalance_ratio()) {
+        set_placement_system_indices(batch_systems_[lane]);
+        calculate_player_scores<Instrumented>();
+        score_imbalance_ratio_ = score_imbalance_ratio();
+        if (score_imbalance_ratio_ < best_board.score_imbalance_ratio()
+            && update_best_board_and_return_success(
+                score_imbalance_ratio_tolerance, best_board,
+                batch_iterations_[lane].first)) {
+          number_of_iterations = batch_iterations_[lane].first;
+          number_of_valid_boards = batch_iterations_[lane].second;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /// \brief Score imbalance of each board of the batch. Each lane holds one
+  /// board. This matches calculate_player_scores() followed by
+  /// score_imbalance_ratio(), up to rounding. The linear terms use the
+  /// placement score weights, and the pathway term uses the same dynamic
+  /// programming as best_scores_to_mecatol_rex(). Lanes beyond the size of
+  /// the batch hold meaningless values.
+  std::array<float, Lanes::size>
+  calculate_batch_score_imbalance_ratios() const noexcept {
+    // The systems containing planets adjacent to home term is two times the
+    // number of such systems minus two, which starts each player at -4.
+    std::array<Lanes, 9> player_scores;
+    player_scores.fill(Lanes{-4.0f});
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      const std::size_t element{index * Lanes::size};
+      const Lanes system_scores{Lanes::load(&batch_system_scores_[element])};
+      const Lanes expansion_scores{
+          Lanes::load(&batch_expansion_scores_[element])};
+      const Lanes planets{Lanes::load(&batch_planets_[element])};
+      for (const PlacementScoreWeight& weight :
+           placement_score_weights_[index]) {
+        player_scores[static_cast<uint8_t>(weight.player)] +=
+            Lanes{weight.system} * system_scores
+            + Lanes{weight.expansion} * expansion_scores
+            + Lanes{weight.planets} * planets;
+      }
+    }
+    std::array<Lanes, 64> best_scores;
+    for (std::size_t distance = 0; distance < pathway_layer_bitboards_.size();
+         ++distance) {
+      Bitboard remaining{pathway_layer_bitboards_[distance]};
+      while (!remaining.empty()) {
+        const uint8_t ordinal{remaining.pop_front()};
+        const uint8_t index{placement_indices_[ordinal]};
+        const Lanes position_scores{
+            index != NoPlacementIndex ?
+                Lanes::load(&batch_pathway_scores_[index * Lanes::size]) :
+                Lanes{pathway_score(
+                    positions_to_tiles_.find(ordinal)->system_index())}};
+        Lanes best_next_scores{0.0f};
+        if (distance > 0) {
+          best_next_scores = Lanes{std::numeric_limits<float>::lowest()};
+          Bitboard nearer{nearer_neighbor_bitboards_[ordinal]};
+          while (!nearer.empty()) {
+            best_next_scores = Lanes::max(
+                best_next_scores, best_scores[nearer.pop_front()]);
+          }
+        }
+        best_scores[ordinal] = position_scores + best_next_scores;
+      }
+    }
+    Lanes maximum_scores{std::numeric_limits<float>::lowest()};
+    Lanes total_scores{0.0f};
+    Lanes minimum_scores{std::numeric_limits<float>::max()};
+    for (const Player player : players_) {
+      const uint8_t player_index{static_cast<uint8_t>(player)};
+      Bitboard starts{pathway_start_bitboards_[player_index]};
+      if (!starts.empty()) {
+        Lanes best_pathway_scores{std::numeric_limits<float>::lowest()};
+        while (!starts.empty()) {
+          best_pathway_scores =
+              Lanes::max(best_pathway_scores, best_scores[starts.pop_front()]);
+        }
+        player_scores[player_index] += best_pathway_scores;
+      }
+      maximum_scores = Lanes::max(maximum_scores, player_scores[player_index]);
+      total_scores += player_scores[player_index];
+      minimum_scores = Lanes::min(minimum_scores, player_scores[player_index]);
+    }
+    const Lanes average_scores{
+        total_scores / Lanes{static_cast<float>(players_.size())}};
+    std::array<float, Lanes::size> score_imbalance_ratios;
+    (Lanes::max(average_scores - minimum_scores,
+                maximum_scores - average_scores)
+     / average_scores)
+        .store(score_imbalance_ratios.data());
+    return score_imbalance_ratios;
+  }
+
+  /// \brief Prints the search counters of each attempt as a JSON object.
+  std::string print_search_counter_records() const noexcept {
+    std::string text{"{\"attempts\":["};
+    for (std::size_t index = 0; index < search_counter_records_.size();
+         ++index) {
+      if (index > 0) {
+        text += ",";
+      }
+      text += search_counter_records_[index];
+    }
+    text += "]}";
+    return text;
+  }
+
   std::string print_player_scores() const noexcept {
     std::string text;
     for (const std::pair<const Player, float>& player_score : player_scores_) {
@@ -849,10 +2320,9 @@ private:
       const int8_t maximum_azimuth_{maximum_azimuth(layer)};
       for (int8_t azimuth = 0; azimuth <= maximum_azimuth_; ++azimuth) {
         const Position position{layer, azimuth};
-        const std::unordered_map<Position, Tile>::const_iterator
-            position_and_tile{positions_to_tiles_.find(position)};
-        if (position_and_tile != positions_to_tiles_.cend()) {
-          ordered_tiles_.insert(position_and_tile->second);
+        const Tile* tile{positions_to_tiles_.find(position)};
+        if (tile != nullptr) {
+          ordered_tiles_.insert(*tile);
         } else {
           // In this case, this is a skipped tile.
           ordered_tiles_.insert({position, "-1"});
@@ -1,8 +1,13 @@
 #pragma once
 
-#include "Pathway.hpp"
+#include "Bitboard.hpp"
+#include "TileArray.hpp"
 #include "Tiles.hpp"
 
+#ifdef TI4CARTOGRAPHER_TOPOLOGIES
+#include "Topologies.hpp"
+#endif
+
 namespace TI4Cartographer {
 
 /// \brief Initializer for the Board class.
@@ -10,22 +15,31 @@ class BoardInitializer {
 public:
   BoardInitializer(const Layout layout) noexcept {
     initialize_tiles(layout);
-    initialize_neighbors();
     initialize_mecatol_rex_position();
     initialize_players(layout);
     initialize_players_home_positions();
+#ifdef TI4CARTOGRAPHER_TOPOLOGIES
+    // The topology of each board layout is precomputed at build time.
+    initialize_topology(Topologies[static_cast<uint8_t>(layout)]);
+#else
+    initialize_neighbors();
     initialize_distances_from_mecatol_rex();
     initialize_distances_from_players_homes();
     initialize_relevant_players_and_equidistant_and_in_slice_positions();
     initialize_forward_and_lateral_positions();
     initialize_mecatol_rex_pathways();
     initialize_preferred_expansion_and_alternate_expansion_positions();
+#endif
+    message_topology();
+    initialize_placement_positions();
+    initialize_bitboards();
+    initialize_automorphisms();
   }
 
 protected:
   /// \brief Collection of tiles that form the board, indexed by their
   /// positions.
-  std::unordered_map<Position, Tile> positions_to_tiles_;
+  TileArray positions_to_tiles_;
 
   int8_t maximum_layer_{0};
 
@@ -78,9 +92,17 @@ protected:
   /// positions that are not nearer to Mecatol Rex than each player's home.
   std::map<Player, std::set<Position>> players_to_lateral_positions_;
 
-  /// \brief Pathways to Mecatol Rex may include equidistant positions and
-  /// always end with the Mecatol Rex position itself.
-  std::map<Player, std::vector<Pathway>> players_to_mecatol_rex_pathways_;
+  /// \brief Positions along the shortest pathways to Mecatol Rex of each
+  /// player. A pathway starts at one of the player's forward positions and
+  /// steps to a neighbor that is one step nearer to Mecatol Rex until it ends
+  /// with the Mecatol Rex position itself. Rather than listing every pathway,
+  /// whose number grows combinatorially with the distance to Mecatol Rex, only
+  /// the positions are kept: together with the edges given by
+  /// nearer_neighbor_bitboards_, they form a directed acyclic graph whose
+  /// paths are exactly the pathways. Pathways may include equidistant
+  /// positions.
+  std::map<Player, std::set<Position>>
+      players_to_mecatol_rex_pathway_positions_;
 
   /// \brief Preferred expansion positions are positions where a player would
   /// ideally want to construct their second space dock and use as a forward
@@ -94,6 +116,89 @@ protected:
   std::map<Player, std::set<Position>>
       players_to_alternate_expansion_positions_;
 
+  /// \brief Planetary/anomaly/wormhole/empty positions on which the
+  /// constructive generator places systems, ordered by layer and azimuth.
+  std::vector<Position> placement_positions_;
+
+  /// \brief For each placement position, whether it is an equidistant position
+  /// rather than an in-slice position.
+  std::vector<bool> placement_is_equidistant_;
+
+  /// \brief For each placement position, the indices of its neighboring
+  /// placement positions.
+  std::vector<std::vector<uint8_t>> placement_neighbors_;
+
+  /// \brief For each placement position, the players whose home is adjacent to
+  /// it, i.e. the players for whom it is a forward or lateral position.
+  std::vector<std::vector<Player>> placement_home_adjacent_players_;
+
+  /// \brief Ordinal of each placement position.
+  std::vector<uint8_t> placement_ordinals_;
+
+  /// \brief Neighbors of each position, indexed by position ordinal.
+  std::array<Bitboard, 64> neighbor_bitboards_;
+
+  /// \brief Forward positions of each player, indexed by player.
+  std::array<Bitboard, 9> forward_bitboards_;
+
+  /// \brief Lateral positions of each player, indexed by player.
+  std::array<Bitboard, 9> lateral_bitboards_;
+
+  /// \brief Preferred expansion positions of each player, indexed by player.
+  std::array<Bitboard, 9> preferred_expansion_bitboards_;
+
+  /// \brief Alternate expansion positions of each player, indexed by player.
+  std::array<Bitboard, 9> alternate_expansion_bitboards_;
+
+  /// \brief Neighbors of each position that are one step nearer to Mecatol
+  /// Rex, indexed by position ordinal. These are the edges of the graph of
+  /// pathways to Mecatol Rex.
+  std::array<Bitboard, 64> nearer_neighbor_bitboards_;
+
+  /// \brief Positions along the pathways to Mecatol Rex of each player,
+  /// indexed by player.
+  std::array<Bitboard, 9> pathway_bitboards_;
+
+  /// \brief Positions at which the pathways to Mecatol Rex of each player
+  /// start, indexed by player.
+  std::array<Bitboard, 9> pathway_start_bitboards_;
+
+  /// \brief Positions along the pathways to Mecatol Rex of any player, indexed
+  /// by distance from Mecatol Rex. Visiting these in order visits each
+  /// position after all of its nearer neighbors.
+  std::vector<Bitboard> pathway_layer_bitboards_;
+
+  /// \brief Symmetry of the board layout: a rotation of the board about
+  /// Mecatol Rex, possibly preceded by a reflection, that maps each tile onto
+  /// a tile of the same kind and each player's home onto a player's home, and
+  /// under which the neighbors, distances, slices, expansion positions, and
+  /// pathways to Mecatol Rex of the players correspond. Boards that differ by
+  /// a symmetry have the same player scores up to a relabeling of the
+  /// players, and thus the same score imbalance and the same validity.
+  struct Automorphism {
+    /// \brief Image of each position, indexed by position ordinal.
+    std::array<uint8_t, 64> ordinals{};
+
+    /// \brief Image of each player, indexed by player.
+    std::array<uint8_t, 9> players{};
+
+    Bitboard image(const Bitboard& bitboard) const noexcept {
+      Bitboard result;
+      Bitboard remaining{bitboard};
+      while (!remaining.empty()) {
+        result.insert(ordinals[remaining.pop_front()]);
+      }
+      return result;
+    }
+  };
+
+  /// \brief Symmetries of this board layout, starting with the identity.
+  std::vector<Automorphism> automorphisms_;
+
+  /// \brief For each placement position, whether it is the first placement
+  /// position of its orbit under the symmetries of this board layout.
+  std::vector<bool> placement_is_orbit_representative_;
+
   bool is_equidistant(const Position& position) const noexcept {
     return equidistant_positions_.find(position)
            != equidistant_positions_.cend();
@@ -107,7 +212,7 @@ protected:
 private:
   void initialize_tiles(const Layout layout) noexcept {
     for (const Tile& tile : tiles(layout)) {
-      positions_to_tiles_.insert({tile.position(), tile});
+      positions_to_tiles_.insert(tile);
       if (tile.position().layer() > maximum_layer_) {
         maximum_layer_ = tile.position().layer();
       }
@@ -115,31 +220,26 @@ private:
   }
 
   void initialize_neighbors() noexcept {
-    for (const std::pair<const Position, Tile>& position_and_tile :
-         positions_to_tiles_) {
-      if (!position_and_tile.second.is_hyperlane()) {
+    for (const Tile& tile : positions_to_tiles_) {
+      if (!tile.is_hyperlane()) {
         std::set<Position> neighbors;
         for (const Position& neighbor_position :
-             position_and_tile.first.possible_neighbors()) {
-          const std::unordered_map<Position, Tile>::const_iterator
-              neighbor_position_and_tile{
+             tile.position().possible_neighbors()) {
+          const Tile* neighbor_tile{
                   positions_to_tiles_.find(neighbor_position)};
-          if (neighbor_position_and_tile != positions_to_tiles_.cend()
-              && !neighbor_position_and_tile->second.is_hyperlane()) {
+          if (neighbor_tile != nullptr && !neighbor_tile->is_hyperlane()) {
             neighbors.insert(neighbor_position);
           }
         }
         for (const Position& neighbor_position :
-             position_and_tile.second.hyperlane_neighbors()) {
-          const std::unordered_map<Position, Tile>::const_iterator
-              neighbor_position_and_tile{
+             tile.hyperlane_neighbors()) {
+          const Tile* neighbor_tile{
                   positions_to_tiles_.find(neighbor_position)};
-          if (neighbor_position_and_tile != positions_to_tiles_.cend()
-              && !neighbor_position_and_tile->second.is_hyperlane()) {
+          if (neighbor_tile != nullptr && !neighbor_tile->is_hyperlane()) {
             neighbors.insert(neighbor_position);
           }
         }
-        neighbors_.emplace(position_and_tile.first, neighbors);
+        neighbors_.emplace(tile.position(), neighbors);
       }
     }
     // Check that all neighbors are symmetric.
@@ -160,13 +260,11 @@ private:
   }
 
   void initialize_mecatol_rex_position() noexcept {
-    for (const std::pair<const Position, Tile>& position_and_tile :
-         positions_to_tiles_) {
-      if (position_and_tile.second.system_id() == MecatolRexSystemId) {
-        mecatol_rex_position_ = position_and_tile.first;
+    for (const Tile& tile : positions_to_tiles_) {
+      if (tile.system_id() == MecatolRexSystemId) {
+        mecatol_rex_position_ = tile.position();
       }
     }
-    verbose_message("Mecatol Rex position: " + mecatol_rex_position_.print());
   }
 
   void initialize_players(const Layout layout) noexcept {
@@ -174,11 +272,9 @@ private:
         players(number_of_players(layout))};
     // Check that the set of tiles contains all the player homes.
     std::set<Player> players_from_tiles;
-    for (const std::pair<const Position, Tile>& position_and_tile :
-         positions_to_tiles_) {
-      if (position_and_tile.second.home_player().has_value()) {
-        players_from_tiles.insert(
-            position_and_tile.second.home_player().value());
+    for (const Tile& tile : positions_to_tiles_) {
+      if (tile.home_player().has_value()) {
+        players_from_tiles.insert(tile.home_player().value());
       }
     }
     if (players_from_layout != players_from_tiles) {
@@ -190,20 +286,13 @@ private:
   }
 
   void initialize_players_home_positions() noexcept {
-    for (const std::pair<const Position, Tile>& position_and_tile :
-         positions_to_tiles_) {
-      if (position_and_tile.second.home_player().has_value()) {
+    for (const Tile& tile : positions_to_tiles_) {
+      if (tile.home_player().has_value()) {
         players_to_home_positions_.emplace(
-            position_and_tile.second.home_player().value(),
-            position_and_tile.first);
+            tile.home_player().value(),
+            tile.position());
       }
     }
-    verbose_message("Home positions:");
-    for (const std::pair<const Player, Position>& player_and_home_position :
-         players_to_home_positions_) {
-      verbose_message("- " + label(player_and_home_position.first) + ": "
-                      + player_and_home_position.second.print());
-    }
   }
 
   void initialize_distances_from_mecatol_rex() noexcept {
@@ -250,13 +339,12 @@ private:
 
   void
   initialize_relevant_players_and_equidistant_and_in_slice_positions() noexcept {
-    for (const std::pair<const Position, Tile>& position_and_tile :
-         positions_to_tiles_) {
-      if (position_and_tile.second.is_planetary_anomaly_wormhole_or_empty()) {
+    for (const Tile& tile : positions_to_tiles_) {
+      if (tile.is_planetary_anomaly_wormhole_or_empty()) {
         const std::unordered_map<Position, std::map<Player, Distance>>::
             const_iterator position_and_players_home_distances{
                 positions_to_players_home_distances_.find(
-                    position_and_tile.first)};
+                    tile.position())};
         // Compute the minimum distance.
         Distance minimum_distance{std::numeric_limits<Distance>::max()};
         for (const std::pair<const Player, Distance>& player_and_distance :
@@ -273,51 +361,43 @@ private:
             relevant_players.insert(player_and_distance.first);
           }
         }
-        // Initialize the relevant players.
-        positions_to_relevant_players_.emplace(
-            position_and_tile.first, relevant_players);
-        // Initialize the equidistant positions.
-        if (relevant_players.size() > 1) {
-          // This is an equidistant position.
-          equidistant_positions_.insert(position_and_tile.first);
-          for (const Player player : relevant_players) {
-            const std::map<Player, std::set<Position>>::iterator found{
-                players_to_equidistant_positions_.find(player)};
-            if (found != players_to_equidistant_positions_.end()) {
-              found->second.insert(position_and_tile.first);
-            } else {
-              players_to_equidistant_positions_.insert(
-                  {player, {position_and_tile.first}});
-            }
-          }
-        } else if (relevant_players.size() == 1) {
-          // This is an in-slice position.
-          const Player first_relevant_player{*(relevant_players.begin())};
-          in_slice_positions_to_players_.emplace(
-              position_and_tile.first, first_relevant_player);
-          const std::map<Player, std::set<Position>>::iterator
-              player_and_in_slice_positions{
-                  players_to_in_slice_positions_.find(first_relevant_player)};
-          if (player_and_in_slice_positions
-              != players_to_in_slice_positions_.cend()) {
-            player_and_in_slice_positions->second.insert(
-                position_and_tile.first);
-          } else {
-            players_to_in_slice_positions_.insert(
-                {first_relevant_player, {position_and_tile.first}});
-          }
-        }
+        insert_relevant_players(tile.position(), relevant_players);
       }
     }
-    verbose_message("Equidistant positions:");
-    for (const Position& position : equidistant_positions_) {
-      verbose_message("- " + position.print());
-    }
-    verbose_message("In-slice positions:");
-    for (const std::pair<const Player, std::set<Position>>&
-             player_and_positions : players_to_in_slice_positions_) {
-      verbose_message("- " + label(player_and_positions.first) + ": "
-                      + print_set(player_and_positions.second));
+  }
+
+  /// \brief Initializes the relevant players of a position and classifies the
+  /// position as an equidistant or in-slice position.
+  void insert_relevant_players(
+      const Position& position,
+      const std::set<Player>& relevant_players) noexcept {
+    positions_to_relevant_players_.emplace(position, relevant_players);
+    if (relevant_players.size() > 1) {
+      // This is an equidistant position.
+      equidistant_positions_.insert(position);
+      for (const Player player : relevant_players) {
+        const std::map<Player, std::set<Position>>::iterator found{
+            players_to_equidistant_positions_.find(player)};
+        if (found != players_to_equidistant_positions_.end()) {
+          found->second.insert(position);
+        } else {
+          players_to_equidistant_positions_.insert({player, {position}});
+        }
+      }
+    } else if (relevant_players.size() == 1) {
+      // This is an in-slice position.
+      const Player first_relevant_player{*(relevant_players.begin())};
+      in_slice_positions_to_players_.emplace(position, first_relevant_player);
+      const std::map<Player, std::set<Position>>::iterator
+          player_and_in_slice_positions{
+              players_to_in_slice_positions_.find(first_relevant_player)};
+      if (player_and_in_slice_positions
+          != players_to_in_slice_positions_.cend()) {
+        player_and_in_slice_positions->second.insert(position);
+      } else {
+        players_to_in_slice_positions_.insert(
+            {first_relevant_player, {position}});
+      }
     }
   }
 
@@ -339,15 +419,12 @@ private:
         for (const Position& neighbor_of_home :
              home_position_and_neighbors->second) {
           // This position is a neighbor of this player's home.
-          const std::unordered_map<Position, Tile>::const_iterator
-              neighbor_position_and_tile{
-                  positions_to_tiles_.find(neighbor_of_home)};
+          const Tile* neighbor_tile{positions_to_tiles_.find(neighbor_of_home)};
           const std::unordered_map<Position, Distance>::const_iterator
               neighbor_position_and_distance{
                   positions_to_distances_from_mecatol_rex_.find(
                       neighbor_of_home)};
-          if (neighbor_position_and_tile != positions_to_tiles_.cend()
-              && !neighbor_position_and_tile->second.is_hyperlane()
+          if (neighbor_tile != nullptr && !neighbor_tile->is_hyperlane()
               && neighbor_position_and_distance
                      != positions_to_distances_from_mecatol_rex_.cend()) {
             // This position is of the correct system category.
@@ -370,18 +447,7 @@ private:
             player_and_home_position.first, lateral_positions);
       }
     }
-    verbose_message("Forward positions:");
-    for (const std::pair<const Player, std::set<Position>>&
-             player_and_positions : players_to_forward_positions_) {
-      verbose_message("- " + label(player_and_positions.first) + ": "
-                      + print_set(player_and_positions.second));
-    }
-    verbose_message("Lateral positions:");
-    for (const std::pair<const Player, std::set<Position>>&
-             player_and_positions : players_to_lateral_positions_) {
-      verbose_message("- " + label(player_and_positions.first) + ": "
-                      + print_set(player_and_positions.second));
-    }
+
   }
 
   void initialize_mecatol_rex_pathways() noexcept {
@@ -391,64 +457,46 @@ private:
               players_to_forward_positions_.find(player)};
       if (player_and_forward_positions
           != players_to_forward_positions_.cend()) {
-        std::vector<Pathway> pathways;
+        // The forward positions are nearer to Mecatol Rex than this player's
+        // home. Therefore, they are the starting points of the pathways to
+        // Mecatol Rex. Due to hyperlanes, some of them may be farther from
+        // Mecatol Rex than others. Keep only the nearest ones so that only the
+        // shortest pathways remain.
+        Distance shortest_distance_to_mecatol_rex{
+            std::numeric_limits<Distance>::max()};
         for (const Position& forward_position :
              player_and_forward_positions->second) {
-          const std::unordered_map<Position, Tile>::const_iterator
-              forward_position_and_tile{
-                  positions_to_tiles_.find(forward_position)};
-          if (forward_position_and_tile != positions_to_tiles_.cend()
-              && !forward_position_and_tile->second.is_hyperlane()) {
-            // This position is of the correct system category and is nearer to
-            // Mecatol Rex than this player's home. Therefore, this position is
-            // a starting point for a pathway to Mecatol Rex.
-            Pathway pathway;
-            pathway.push_back(forward_position_and_tile->first);
-            pathways.push_back(pathway);
-          }
+          shortest_distance_to_mecatol_rex =
+              std::min(shortest_distance_to_mecatol_rex,
+                       positions_to_distances_from_mecatol_rex_.at(
+                           forward_position));
         }
-        // At this point, we likely have at least 1 position that serves as a
-        // start for the pathways to Mecatol Rex. For each pathway, grow it
-        // procedurally by moving nearer to Mecatol Rex. Some pathways can fork
-        // into multiple pathways.
-        while (!pathways.empty() && !all_reach_mecatol_rex(pathways)) {
-          std::vector<Pathway> updated_pathways;
-          for (const Pathway& pathway : pathways) {
-            const std::set<Position> next_positions{
-                neighbors_nearer_to_mecatol_rex(pathway.back())};
-            for (const Position& next_position : next_positions) {
-              Pathway updated_pathway{pathway};
-              updated_pathway.push_back(next_position);
-              updated_pathways.push_back(updated_pathway);
-            }
-          }
-          pathways = updated_pathways;
-        }
-        // At this point, the pathways to Mecatol Rex have all been assembled.
-        // However, due to hyperlanes, some pathways to Mecatol Rex may be
-        // longer than others. Keep only the shortest pathways.
-        Distance shortest_pathway_distance_to_mecatol_rex{
-            std::numeric_limits<Distance>::max()};
-        for (const Pathway& pathway : pathways) {
-          if (pathway.distance() < shortest_pathway_distance_to_mecatol_rex) {
-            shortest_pathway_distance_to_mecatol_rex = pathway.distance();
+        std::set<Position> current_positions;
+        for (const Position& forward_position :
+             player_and_forward_positions->second) {
+          if (positions_to_distances_from_mecatol_rex_.at(forward_position)
+              == shortest_distance_to_mecatol_rex) {
+            current_positions.insert(forward_position);
           }
         }
-        std::vector<Pathway> shortest_pathways;
-        for (const Pathway& pathway : pathways) {
-          if (pathway.distance() == shortest_pathway_distance_to_mecatol_rex) {
-            shortest_pathways.push_back(pathway);
+        // Move nearer to Mecatol Rex one step at a time. Each position is
+        // visited once, no matter how many pathways pass through it.
+        std::set<Position> pathway_positions;
+        while (!current_positions.empty()) {
+          std::set<Position> next_positions;
+          for (const Position& position : current_positions) {
+            pathway_positions.insert(position);
+            for (const Position& next_position :
+                 neighbors_nearer_to_mecatol_rex(position)) {
+              next_positions.insert(next_position);
+            }
           }
+          current_positions = next_positions;
         }
-        players_to_mecatol_rex_pathways_.emplace(player, shortest_pathways);
+        players_to_mecatol_rex_pathway_positions_.emplace(
+            player, pathway_positions);
       }
     }
-    verbose_message("Pathways to Mecatol Rex:");
-    for (const std::pair<const Player, std::vector<Pathway>>&
-             player_and_pathways : players_to_mecatol_rex_pathways_) {
-      verbose_message("- " + label(player_and_pathways.first) + ": "
-                      + print_vector(player_and_pathways.second));
-    }
   }
 
   void
@@ -462,14 +510,13 @@ private:
     // preferred expansion position, choose the one with the largest distance
     // from other players' homes. The same applies to the alternate positions.
     for (const Player player : players_) {
-      const std::map<Player, std::vector<Pathway>>::const_iterator
-          player_and_pathways_to_mecatol_rex{
-              players_to_mecatol_rex_pathways_.find(player)};
-      if (player_and_pathways_to_mecatol_rex
-              != players_to_mecatol_rex_pathways_.cend()
-          && !player_and_pathways_to_mecatol_rex->second.empty()) {
-        const Distance pathway_distance{
-            player_and_pathways_to_mecatol_rex->second.begin()->distance()};
+      const std::map<Player, std::set<Position>>::const_iterator
+          player_and_pathway_positions{
+              players_to_mecatol_rex_pathway_positions_.find(player)};
+      if (player_and_pathway_positions
+              != players_to_mecatol_rex_pathway_positions_.cend()
+          && !player_and_pathway_positions->second.empty()) {
+        const Distance pathway_distance{mecatol_rex_pathway_distance(player)};
         // If the pathways to Mecatol Rex have length 1, the player's home is
         // adjacent to Mecatol Rex, so there are no preferred or alternate
         // positions.
@@ -525,24 +572,395 @@ private:
         // longer.
       }
     }
+  }
+
+#ifdef TI4CARTOGRAPHER_TOPOLOGIES
+  /// \brief Initializes the neighbors, distances, relevant players, forward
+  /// and lateral positions, pathways to Mecatol Rex, and expansion positions
+  /// from the topology table of this board layout, which is generated at build
+  /// time. This is equivalent to the initialization functions above but does
+  /// not search the board.
+  void initialize_topology(const Topology& topology) noexcept {
+    std::array<Position, 64> ordinals_to_positions;
+    for (const Tile& tile : positions_to_tiles_) {
+      ordinals_to_positions[tile.position().ordinal()] = tile.position();
+    }
+    const auto positions{
+        [&ordinals_to_positions](const uint64_t mask) -> std::set<Position> {
+          std::set<Position> positions_;
+          Bitboard bitboard{mask};
+          while (!bitboard.empty()) {
+            positions_.insert(ordinals_to_positions[bitboard.pop_front()]);
+          }
+          return positions_;
+        }};
+    for (const Tile& tile : positions_to_tiles_) {
+      const uint8_t ordinal{tile.position().ordinal()};
+      if (!tile.is_hyperlane()) {
+        neighbors_.emplace(
+            tile.position(), positions(topology.neighbors[ordinal]));
+      }
+      if (topology.distances_from_mecatol_rex[ordinal] != NoTopologyDistance) {
+        const Distance distance{topology.distances_from_mecatol_rex[ordinal]};
+        positions_to_distances_from_mecatol_rex_.emplace(
+            tile.position(), distance);
+        if (distance > maximum_distance_from_mecatol_rex_) {
+          maximum_distance_from_mecatol_rex_ = distance;
+        }
+      }
+      std::map<Player, Distance> players_to_distances;
+      for (const Player player : players_) {
+        const int8_t distance{topology.distances_from_players_homes
+                                  [ordinal][static_cast<uint8_t>(player)]};
+        if (distance != NoTopologyDistance) {
+          players_to_distances.emplace(player, distance);
+        }
+      }
+      if (!players_to_distances.empty()) {
+        positions_to_players_home_distances_.emplace(
+            tile.position(), players_to_distances);
+      }
+      if (tile.is_planetary_anomaly_wormhole_or_empty()) {
+        std::set<Player> relevant_players;
+        for (const Player player : players_) {
+          if ((topology.relevant_players[ordinal]
+               >> static_cast<uint8_t>(player))
+              & 1U) {
+            relevant_players.insert(player);
+          }
+        }
+        insert_relevant_players(tile.position(), relevant_players);
+      }
+    }
+    for (const std::pair<const Player, Position>& player_and_home_position :
+         players_to_home_positions_) {
+      const uint8_t player{static_cast<uint8_t>(player_and_home_position.first)};
+      players_to_forward_positions_.emplace(
+          player_and_home_position.first,
+          positions(topology.forward_positions[player]));
+      players_to_lateral_positions_.emplace(
+          player_and_home_position.first,
+          positions(topology.lateral_positions[player]));
+    }
+    for (const std::pair<const Player, Position>& player_and_home_position :
+         players_to_home_positions_) {
+      players_to_mecatol_rex_pathway_positions_.emplace(
+          player_and_home_position.first,
+          positions(topology.mecatol_rex_pathway_positions[static_cast<uint8_t>(
+              player_and_home_position.first)]));
+    }
+    for (const Player player : players_) {
+      const uint8_t number{static_cast<uint8_t>(player)};
+      if ((topology.preferred_expansion_players >> number) & 1U) {
+        players_to_preferred_expansion_positions_.emplace(
+            player, positions(topology.preferred_expansion_positions[number]));
+      }
+      if ((topology.alternate_expansion_players >> number) & 1U) {
+        players_to_alternate_expansion_positions_.emplace(
+            player, positions(topology.alternate_expansion_positions[number]));
+      }
+    }
+  }
+#endif
+
+  void message_topology() const noexcept {
+    verbose_message("Mecatol Rex position: " + mecatol_rex_position_.print());
+    verbose_message("Home positions:");
+    for (const std::pair<const Player, Position>& player_and_home_position :
+         players_to_home_positions_) {
+      verbose_message("- " + label(player_and_home_position.first) + ": "
+                      + player_and_home_position.second.print());
+    }
+    verbose_message("Equidistant positions:");
+    for (const Position& position : equidistant_positions_) {
+      verbose_message("- " + position.print());
+    }
+    verbose_message("In-slice positions:");
+    for (const std::pair<const Player, std::set<Position>>&
+             player_and_positions : players_to_in_slice_positions_) {
+      verbose_message("- " + label(player_and_positions.first) + ": "
+                      + print_set(player_and_positions.second));
+    }
+    verbose_message("Forward positions:");
+    for (const std::pair<const Player, std::set<Position>>&
+             player_and_positions : players_to_forward_positions_) {
+      verbose_message("- " + label(player_and_positions.first) + ": "
+                      + print_set(player_and_positions.second));
+    }
+    verbose_message("Lateral positions:");
+    for (const std::pair<const Player, std::set<Position>>&
+             player_and_positions : players_to_lateral_positions_) {
+      verbose_message("- " + label(player_and_positions.first) + ": "
+                      + print_set(player_and_positions.second));
+    }
+    verbose_message("Pathways to Mecatol Rex:");
+    for (const std::pair<const Player, std::set<Position>>&
+             player_and_positions : players_to_mecatol_rex_pathway_positions_) {
+      verbose_message("- " + label(player_and_positions.first) + ": "
+                      + print_set(player_and_positions.second));
+    }
     verbose_message("Preferred positions:");
     for (const std::pair<const Player, std::set<Position>>&
-             player_and_preferred_expansion_positions :
-         players_to_preferred_expansion_positions_) {
-      verbose_message(
-          "- " + label(player_and_preferred_expansion_positions.first) + ": "
-          + print_set(player_and_preferred_expansion_positions.second));
+             player_and_positions : players_to_preferred_expansion_positions_) {
+      verbose_message("- " + label(player_and_positions.first) + ": "
+                      + print_set(player_and_positions.second));
     }
     verbose_message("Alternate positions:");
     for (const std::pair<const Player, std::set<Position>>&
-             player_and_alternate_expansion_positions :
-         players_to_alternate_expansion_positions_) {
-      verbose_message(
-          "- " + label(player_and_alternate_expansion_positions.first) + ": "
-          + print_set(player_and_alternate_expansion_positions.second));
+             player_and_positions : players_to_alternate_expansion_positions_) {
+      verbose_message("- " + label(player_and_positions.first) + ": "
+                      + print_set(player_and_positions.second));
+    }
+  }
+
+  void initialize_placement_positions() noexcept {
+    std::unordered_map<Position, uint8_t> positions_to_placement_indices;
+    for (int8_t layer = 0; layer <= maximum_layer_; ++layer) {
+      const int8_t maximum_azimuth_{maximum_azimuth(layer)};
+      for (int8_t azimuth = 0; azimuth <= maximum_azimuth_; ++azimuth) {
+        const Position position{layer, azimuth};
+        const Tile* tile{positions_to_tiles_.find(position)};
+        if (tile != nullptr && tile->is_planetary_anomaly_wormhole_or_empty()) {
+          positions_to_placement_indices.emplace(
+              position, static_cast<uint8_t>(placement_positions_.size()));
+          placement_positions_.push_back(position);
+          placement_is_equidistant_.push_back(is_equidistant(position));
+        }
+      }
+    }
+    placement_neighbors_.resize(placement_positions_.size());
+    placement_home_adjacent_players_.resize(placement_positions_.size());
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      const std::unordered_map<Position, std::set<Position>>::const_iterator
+          position_and_neighbors{neighbors_.find(placement_positions_[index])};
+      if (position_and_neighbors != neighbors_.cend()) {
+        for (const Position& neighbor : position_and_neighbors->second) {
+          const std::unordered_map<Position, uint8_t>::const_iterator
+              neighbor_and_index{positions_to_placement_indices.find(neighbor)};
+          if (neighbor_and_index != positions_to_placement_indices.cend()) {
+            placement_neighbors_[index].push_back(neighbor_and_index->second);
+          }
+        }
+      }
+    }
+    for (const std::map<Player, std::set<Position>>& players_to_positions :
+         {players_to_forward_positions_, players_to_lateral_positions_}) {
+      for (const std::pair<const Player, std::set<Position>>&
+               player_and_positions : players_to_positions) {
+        for (const Position& position : player_and_positions.second) {
+          const std::unordered_map<Position, uint8_t>::const_iterator
+              position_and_index{positions_to_placement_indices.find(position)};
+          if (position_and_index != positions_to_placement_indices.cend()) {
+            placement_home_adjacent_players_[position_and_index->second]
+                .push_back(player_and_positions.first);
+          }
+        }
+      }
     }
   }
 
+  void initialize_bitboards() noexcept {
+    for (const Position& position : placement_positions_) {
+      placement_ordinals_.push_back(position.ordinal());
+    }
+    for (const std::pair<const Position, std::set<Position>>&
+             position_and_neighbors : neighbors_) {
+      for (const Position& neighbor : position_and_neighbors.second) {
+        neighbor_bitboards_[position_and_neighbors.first.ordinal()].insert(
+            neighbor);
+      }
+    }
+    const auto initialize_player_bitboards{
+        [](const std::map<Player, std::set<Position>>& players_to_positions,
+           std::array<Bitboard, 9>& bitboards) {
+          for (const std::pair<const Player, std::set<Position>>&
+                   player_and_positions : players_to_positions) {
+            for (const Position& position : player_and_positions.second) {
+              bitboards[static_cast<uint8_t>(player_and_positions.first)]
+                  .insert(position);
+            }
+          }
+        }};
+    initialize_player_bitboards(
+        players_to_forward_positions_, forward_bitboards_);
+    initialize_player_bitboards(
+        players_to_lateral_positions_, lateral_bitboards_);
+    initialize_player_bitboards(players_to_preferred_expansion_positions_,
+                                preferred_expansion_bitboards_);
+    initialize_player_bitboards(players_to_alternate_expansion_positions_,
+                                alternate_expansion_bitboards_);
+    initialize_player_bitboards(
+        players_to_mecatol_rex_pathway_positions_, pathway_bitboards_);
+    for (const Player player : players_) {
+      const uint8_t player_index{static_cast<uint8_t>(player)};
+      pathway_start_bitboards_[player_index] =
+          forward_bitboards_[player_index] & pathway_bitboards_[player_index];
+    }
+    for (const std::pair<const Position, Distance>& position_and_distance :
+         positions_to_distances_from_mecatol_rex_) {
+      for (const Position& neighbor :
+           neighbors_nearer_to_mecatol_rex(position_and_distance.first)) {
+        nearer_neighbor_bitboards_[position_and_distance.first.ordinal()]
+            .insert(neighbor);
+      }
+    }
+    pathway_layer_bitboards_.resize(
+        static_cast<std::size_t>(maximum_distance_from_mecatol_rex_.value())
+        + 1);
+    for (const std::pair<const Player, std::set<Position>>&
+             player_and_positions : players_to_mecatol_rex_pathway_positions_) {
+      for (const Position& position : player_and_positions.second) {
+        pathway_layer_bitboards_[static_cast<std::size_t>(
+                                     positions_to_distances_from_mecatol_rex_
+                                         .at(position)
+                                         .value())]
+            .insert(position);
+      }
+    }
+  }
+
+  /// \brief Finds the symmetries of this board layout among the 6 rotations
+  /// and 6 reflections of the hexagonal grid about Mecatol Rex.
+  void initialize_automorphisms() noexcept {
+    for (const bool reflection : {false, true}) {
+      for (int8_t rotation = 0; rotation < 6; ++rotation) {
+        Automorphism automorphism;
+        if (is_automorphism(reflection, rotation, automorphism)) {
+          automorphisms_.push_back(automorphism);
+        }
+      }
+    }
+    placement_is_orbit_representative_.assign(
+        placement_positions_.size(), true);
+    for (std::size_t index = 0; index < placement_positions_.size(); ++index) {
+      for (const Automorphism& automorphism : automorphisms_) {
+        if (automorphism.ordinals[placement_ordinals_[index]]
+            < placement_ordinals_[index]) {
+          placement_is_orbit_representative_[index] = false;
+        }
+      }
+    }
+    verbose_message("Symmetries of the board layout: "
+                    + std::to_string(automorphisms_.size()));
+  }
+
+  /// \brief Image of a position under a reflection about the axis through
+  /// Mecatol Rex and the first corner of each layer, if any, followed by a
+  /// rotation by a multiple of 60 degrees.
+  static Position transformed(const Position& position, const bool reflection,
+                              const int8_t rotation) noexcept {
+    const int8_t layer{position.layer()};
+    if (layer <= 0) {
+      return position;
+    }
+    const int8_t size{static_cast<int8_t>(6 * layer)};
+    int8_t azimuth{position.azimuth()};
+    if (reflection) {
+      azimuth = static_cast<int8_t>((size - azimuth) % size);
+    }
+    return {layer, static_cast<int8_t>((azimuth + rotation * layer) % size)};
+  }
+
+  /// \brief Returns true if the given transformation is a symmetry of this
+  /// board layout, in which case the automorphism is filled in.
+  bool is_automorphism(const bool reflection, const int8_t rotation,
+                       Automorphism& automorphism) const noexcept {
+    for (uint8_t ordinal = 0; ordinal < automorphism.ordinals.size();
+         ++ordinal) {
+      automorphism.ordinals[ordinal] = ordinal;
+    }
+    // Every tile maps onto a tile of the same kind.
+    for (const Tile& tile : positions_to_tiles_) {
+      const Position image{transformed(tile.position(), reflection, rotation)};
+      const Tile* image_tile{positions_to_tiles_.find(image)};
+      if (image_tile == nullptr
+          || image_tile->is_hyperlane() != tile.is_hyperlane()
+          || image_tile->is_planetary_anomaly_wormhole_or_empty()
+                 != tile.is_planetary_anomaly_wormhole_or_empty()
+          || image_tile->home_player().has_value()
+                 != tile.home_player().has_value()
+          || (!tile.is_planetary_anomaly_wormhole_or_empty()
+              && !tile.home_player().has_value() && !tile.is_hyperlane()
+              && image_tile->system_index() != tile.system_index())) {
+        return false;
+      }
+      automorphism.ordinals[tile.position().ordinal()] = image.ordinal();
+      if (tile.home_player().has_value()) {
+        automorphism.players[static_cast<uint8_t>(
+            tile.home_player().value())] =
+            static_cast<uint8_t>(image_tile->home_player().value());
+      }
+    }
+    // The neighbors and the pathways to Mecatol Rex correspond.
+    for (const std::pair<const Position, std::set<Position>>&
+             position_and_neighbors : neighbors_) {
+      const uint8_t ordinal{position_and_neighbors.first.ordinal()};
+      const uint8_t image{automorphism.ordinals[ordinal]};
+      if (automorphism.image(neighbor_bitboards_[ordinal])
+              != neighbor_bitboards_[image]
+          || automorphism.image(nearer_neighbor_bitboards_[ordinal])
+                 != nearer_neighbor_bitboards_[image]) {
+        return false;
+      }
+    }
+    // The distances from the players' homes and the relevant players
+    // correspond.
+    for (const std::pair<const Position, std::map<Player, Distance>>&
+             position_and_distances : positions_to_players_home_distances_) {
+      const std::unordered_map<Position, std::map<Player, Distance>>::
+          const_iterator image_and_distances{
+              positions_to_players_home_distances_.find(transformed(
+                  position_and_distances.first, reflection, rotation))};
+      if (image_and_distances == positions_to_players_home_distances_.cend()) {
+        return false;
+      }
+      for (const std::pair<const Player, Distance>& player_and_distance :
+           position_and_distances.second) {
+        const std::map<Player, Distance>::const_iterator image_distance{
+            image_and_distances->second.find(static_cast<Player>(
+                automorphism.players[static_cast<uint8_t>(
+                    player_and_distance.first)]))};
+        if (image_distance == image_and_distances->second.cend()
+            || image_distance->second != player_and_distance.second) {
+          return false;
+        }
+      }
+    }
+    for (const std::pair<const Position, std::set<Player>>&
+             position_and_players : positions_to_relevant_players_) {
+      const std::unordered_map<Position, std::set<Player>>::const_iterator
+          image_and_players{positions_to_relevant_players_.find(transformed(
+              position_and_players.first, reflection, rotation))};
+      if (image_and_players == positions_to_relevant_players_.cend()
+          || image_and_players->second.size()
+                 != position_and_players.second.size()) {
+        return false;
+      }
+      for (const Player player : position_and_players.second) {
+        if (image_and_players->second.find(static_cast<Player>(
+                automorphism.players[static_cast<uint8_t>(player)]))
+            == image_and_players->second.cend()) {
+          return false;
+        }
+      }
+    }
+    // The positions of each player correspond to those of its image.
+    for (const Player player : players_) {
+      const uint8_t player_index{static_cast<uint8_t>(player)};
+      const uint8_t image{automorphism.players[player_index]};
+      for (const std::array<Bitboard, 9>* bitboards :
+           {&forward_bitboards_, &lateral_bitboards_,
+            &preferred_expansion_bitboards_, &alternate_expansion_bitboards_,
+            &pathway_bitboards_}) {
+        if (automorphism.image((*bitboards)[player_index])
+            != (*bitboards)[image]) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
   /// \brief Returns a map of all non-hyperlane tiles present on the board along
   /// with their distance to a given target position.
   std::unordered_map<Position, Distance> positions_and_distances_from_target(
@@ -554,11 +972,8 @@ private:
     std::unordered_set<Position> next_neighbors;
     while (!current_neighbors.empty() || !next_neighbors.empty()) {
       for (const Position& current_position : current_neighbors) {
-        const std::unordered_map<Position, Tile>::const_iterator
-            current_position_and_tile{
-                positions_to_tiles_.find(current_position)};
-        if (current_position_and_tile != positions_to_tiles_.cend()
-            && !current_position_and_tile->second.is_hyperlane()
+        const Tile* current_tile{positions_to_tiles_.find(current_position)};
+        if (current_tile != nullptr && !current_tile->is_hyperlane()
             && visited.find(current_position) == visited.cend()) {
           // The current position exists, is of the correct system category, and
           // has not yet been visited.
@@ -567,15 +982,12 @@ private:
               current_position, distance_from_target_position);
           const std::unordered_map<Position, std::set<Position>>::const_iterator
               position_and_neighbors{
-                  neighbors_.find(current_position_and_tile->first)};
+                  neighbors_.find(current_tile->position())};
           if (position_and_neighbors != neighbors_.cend()) {
             for (const Position& next_position :
                  position_and_neighbors->second) {
-              const std::unordered_map<Position, Tile>::const_iterator
-                  next_position_and_tile{
-                      positions_to_tiles_.find(next_position)};
-              if (next_position_and_tile != positions_to_tiles_.cend()
-                  && !next_position_and_tile->second.is_hyperlane()
+              const Tile* next_tile{positions_to_tiles_.find(next_position)};
+              if (next_tile != nullptr && !next_tile->is_hyperlane()
                   && visited.find(next_position) == visited.cend()) {
                 // The next position has not been visited.
                 next_neighbors.insert(next_position);
@@ -599,37 +1011,32 @@ private:
   std::set<Position> neighbors_nearer_to_mecatol_rex(
       const Position& reference) const noexcept {
     std::set<Position> neighbors_nearer_to_mecatol_rex_;
-    const std::unordered_map<Position, Tile>::const_iterator
-        reference_position_and_tile{positions_to_tiles_.find(reference)};
+    const Tile* reference_tile{positions_to_tiles_.find(reference)};
     const std::unordered_map<Position, Distance>::const_iterator
         reference_position_and_distance{
             positions_to_distances_from_mecatol_rex_.find(reference)};
-    if (reference_position_and_tile != positions_to_tiles_.cend()
-        && !reference_position_and_tile->second.is_hyperlane()
+    if (reference_tile != nullptr && !reference_tile->is_hyperlane()
         && reference_position_and_distance
                != positions_to_distances_from_mecatol_rex_.cend()) {
       // The reference exists on the board and is of the correct system
       // category.
       const std::unordered_map<Position, std::set<Position>>::const_iterator
           position_and_neighbors{
-              neighbors_.find(reference_position_and_tile->first)};
+              neighbors_.find(reference_tile->position())};
       if (position_and_neighbors != neighbors_.cend()) {
         for (const Position& neighbor : position_and_neighbors->second) {
-          const std::unordered_map<Position, Tile>::const_iterator
-              neighbor_position_and_tile{positions_to_tiles_.find(neighbor)};
+          const Tile* neighbor_tile{positions_to_tiles_.find(neighbor)};
           const std::unordered_map<Position, Distance>::const_iterator
               neighbor_position_and_distance{
                   positions_to_distances_from_mecatol_rex_.find(neighbor)};
-          if (neighbor_position_and_tile != positions_to_tiles_.cend()
-              && !neighbor_position_and_tile->second.is_hyperlane()
+          if (neighbor_tile != nullptr && !neighbor_tile->is_hyperlane()
               && neighbor_position_and_distance
                      != positions_to_distances_from_mecatol_rex_.cend()
               && neighbor_position_and_distance->second
                      < reference_position_and_distance->second) {
             // This neighbor is of the correct system category and is nearer to
             // Mecatol Rex than the reference.
-            neighbors_nearer_to_mecatol_rex_.insert(
-                neighbor_position_and_tile->first);
+            neighbors_nearer_to_mecatol_rex_.insert(neighbor_tile->position());
           }
         }
       }
@@ -637,31 +1044,40 @@ private:
     return neighbors_nearer_to_mecatol_rex_;
   }
 
-  /// \brief Helper function used during the initialization of the pathways to
-  /// Mecatol Rex.
-  bool all_reach_mecatol_rex(
-      const std::vector<Pathway>& pathways) const noexcept {
-    for (const Pathway& pathway : pathways) {
-      if (pathway.empty() || pathway.back() != mecatol_rex_position_) {
-        return false;
-      }
+  /// \brief Number of positions along each of the shortest pathways to Mecatol
+  /// Rex of a player, including the Mecatol Rex position itself.
+  Distance mecatol_rex_pathway_distance(const Player player) const noexcept {
+    Distance distance{0};
+    for (const Position& position :
+         players_to_mecatol_rex_pathway_positions_.at(player)) {
+      distance = std::max(
+          distance, positions_to_distances_from_mecatol_rex_.at(position));
     }
-    return true;
+    return {static_cast<int8_t>(distance.value() + 1)};
   }
 
   /// \brief Helper function used during the initialization of the preferred and
   /// alternate space dock positions.
   std::set<Position> optimal_positions(
       const Player& player, const uint8_t index_along_pathway) const noexcept {
-    // Obtain the pathways for this player.
-    const std::map<Player, std::vector<Pathway>>::const_iterator
-        player_and_pathway_to_mecatol_rex{
-            players_to_mecatol_rex_pathways_.find(player)};
+    // Obtain the positions at the index along the pathways for this player.
+    // The position at a given index along a pathway is always at the same
+    // distance from Mecatol Rex.
+    const Distance distance_from_mecatol_rex{static_cast<int8_t>(
+        mecatol_rex_pathway_distance(player).value() - 1
+        - index_along_pathway)};
+    std::set<Position> positions_at_index;
+    for (const Position& position :
+         players_to_mecatol_rex_pathway_positions_.at(player)) {
+      if (positions_to_distances_from_mecatol_rex_.at(position)
+          == distance_from_mecatol_rex) {
+        positions_at_index.insert(position);
+      }
+    }
     // Compute the maximum-minimum distance from other players' homes for all
     // positions at the index.
     Distance maximum_distance_from_other_players_homes_{0};
-    for (const Pathway& pathway : player_and_pathway_to_mecatol_rex->second) {
-      const Position position{pathway[index_along_pathway]};
+    for (const Position& position : positions_at_index) {
       // Optimal positions cannot be equidistant positions.
       if (equidistant_positions_.find(position)
           == equidistant_positions_.cend()) {
@@ -680,8 +1096,7 @@ private:
     std::map<Position, uint8_t>
         optimal_positions_and_number_of_equidistant_neighbors;
     uint8_t maximum_number_of_equidistant_neighbors{0};
-    for (const Pathway& pathway : player_and_pathway_to_mecatol_rex->second) {
-      const Position position{pathway[index_along_pathway]};
+    for (const Position& position : positions_at_index) {
       // Optimal positions cannot be equidistant positions.
       // However, prefer optimal positions that have many equidistant neighbors.
       if (equidistant_positions_.find(position)
@@ -748,17 +1163,6 @@ private:
     return minimum_distance_from_other_players_homes_;
   }
 
-  uint8_t number_of_equidistant_systems(const Pathway& pathway) const noexcept {
-    uint8_t number_of_equidistant_systems_{0};
-    for (const Position& position : pathway) {
-      if (equidistant_positions_.find(position)
-          != equidistant_positions_.cend()) {
-        ++number_of_equidistant_systems_;
-      }
-    }
-    return number_of_equidistant_systems_;
-  }
-
 };  // class BoardInitializer
 
 }  // namespace TI4Cartographer
@@ -1,15 +1,23 @@
 #include "Board.hpp"
 #include "Instructions.hpp"
 #include "SelectedSystemIds.hpp"
+#include "Server.hpp"
 
 int main(int argc, char* argv[]) {
   const TI4Cartographer::Chronometre chronometre;
 
   const TI4Cartographer::Instructions instructions{argc, argv};
 
-  const TI4Cartographer::Board board{
-      chronometre, instructions.game_version(), instructions.layout(),
-      instructions.aggression()};
+  TI4Cartographer::install_stop_signal_handlers();
+
+  if (instructions.serve()) {
+    TI4Cartographer::Server server{
+        instructions.socket_path(), instructions.settings()};
+    server.run();
+    return EXIT_SUCCESS;
+  }
+
+  const TI4Cartographer::Board board{chronometre, instructions.settings()};
 
   TI4Cartographer::verbose_message(
       "End of " + TI4Cartographer::ProgramName + ".");
@@ -4,14 +4,17 @@
 
 namespace TI4Cartographer {
 
-/// \brief Throw an exception.
+/// \brief Throw an exception. Console output is buffered, so flush it first in
+/// case the exception terminates the program.
 inline void error(const std::string& text) {
+  std::cout.flush();
   throw std::runtime_error(text);
 }
 
 enum class CommunicatorMode : uint8_t {
   Verbose,
   Quiet,
+  Silent,
 };
 
 template <>
@@ -19,6 +22,7 @@ const std::unordered_map<CommunicatorMode, std::string>
     labels<CommunicatorMode>{
         {CommunicatorMode::Verbose, "Verbose"},
         {CommunicatorMode::Quiet,   "Quiet"  },
+        {CommunicatorMode::Silent,  "Silent" },
 };
 
 template <>
@@ -26,10 +30,11 @@ const std::unordered_map<std::string, CommunicatorMode>
     spellings<CommunicatorMode>{
         {"verbose", CommunicatorMode::Verbose},
         {"quiet",   CommunicatorMode::Quiet  },
+        {"silent",  CommunicatorMode::Silent },
 };
 
 /// \brief Singleton class that tracks whether the quiet or verbose mode is used
-/// for console messages.
+/// for console messages. In silent mode, neither is printed.
 class Communicator {
 public:
   /// \brief Obtain an instance of this singleton class.
@@ -58,11 +63,18 @@ public:
     return label(mode_);
   }
 
+  /// \brief Mutex that serializes console output from multiple threads.
+  std::mutex& output_mutex() noexcept {
+    return output_mutex_;
+  }
+
 private:
   bool is_initialized_{false};
 
   CommunicatorMode mode_{CommunicatorMode::Verbose};
 
+  std::mutex output_mutex_;
+
   Communicator() noexcept {};
 
   Communicator(const Communicator&) noexcept = delete;
@@ -76,22 +88,41 @@ private:
 /// \brief Print a general-purpose message to the console when in verbose mode.
 inline void verbose_message(const std::string& text) noexcept {
   if (Communicator::get().mode() == CommunicatorMode::Verbose) {
-    std::cout << text << std::endl;
+    const std::lock_guard<std::mutex> lock{Communicator::get().output_mutex()};
+    std::cout << text << '\n';
   }
 }
 
 /// \brief Print a general-purpose message to the console when in quiet mode.
 inline void quiet_message(const std::string& text) noexcept {
   if (Communicator::get().mode() == CommunicatorMode::Quiet) {
-    std::cout << text << std::endl;
+    const std::lock_guard<std::mutex> lock{Communicator::get().output_mutex()};
+    std::cout << text << '\n';
+  }
+}
+
+/// \brief Print a message to the console in both the verbose and the quiet
+/// modes, such as output that the user explicitly requested.
+inline void message(const std::string& text) noexcept {
+  if (Communicator::get().mode() != CommunicatorMode::Silent) {
+    const std::lock_guard<std::mutex> lock{Communicator::get().output_mutex()};
+    std::cout << text << '\n';
   }
 }
 
 /// \brief Print a debugging message to the console when in verbose mode.
 inline void debug_message(const std::string& text) noexcept {
   if (Communicator::get().mode() == CommunicatorMode::Verbose) {
-    std::cout << "DEBUG: " << text << std::endl;
+    const std::lock_guard<std::mutex> lock{Communicator::get().output_mutex()};
+    std::cout << "DEBUG: " << text << '\n';
   }
 }
 
+/// \brief Messages are buffered rather than flushed one at a time. Call this
+/// once a unit of output, such as a complete board, has been printed.
+inline void flush_messages() noexcept {
+  const std::lock_guard<std::mutex> lock{Communicator::get().output_mutex()};
+  std::cout.flush();
+}
+
 }  // namespace TI4Cartographer
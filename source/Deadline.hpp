@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Set when the program receives SIGINT or SIGTERM. The searches then
+/// stop as soon as possible and the best board found so far is printed.
+std::atomic<bool> StopRequested{false};
+
+inline void request_stop(const int signal_number) noexcept {
+  StopRequested.store(true, std::memory_order_relaxed);
+  // A second signal terminates the program immediately.
+  std::signal(signal_number, SIG_DFL);
+}
+
+/// \brief Call this once from the main thread.
+inline void install_stop_signal_handlers() noexcept {
+  std::signal(SIGINT, request_stop);
+  std::signal(SIGTERM, request_stop);
+}
+
+/// \brief Wall-clock deadline of a search. A deadline without a time limit
+/// only expires when a stop is requested by a signal.
+class Deadline {
+public:
+  Deadline() noexcept {}
+
+  /// \brief A time limit of 0 means that there is no time limit. So does a
+  /// time limit that ends beyond the range of the clock, which would otherwise
+  /// overflow and expire at once.
+  explicit Deadline(const uint64_t time_limit_milliseconds) noexcept {
+    const std::chrono::steady_clock::time_point now{
+        std::chrono::steady_clock::now()};
+    const uint64_t maximum_milliseconds{static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::time_point::max() - now)
+            .count())};
+    if (time_limit_milliseconds > 0
+        && time_limit_milliseconds < maximum_milliseconds) {
+      has_time_limit_ = true;
+      end_ = now
+             + std::chrono::milliseconds(
+                 static_cast<std::chrono::milliseconds::rep>(
+                     time_limit_milliseconds));
+    }
+  }
+
+  /// \brief Reading the clock costs tens of nanoseconds, so search loops only
+  /// call this once every few hundred iterations.
+  bool expired() const noexcept {
+    return StopRequested.load(std::memory_order_relaxed)
+           || (has_time_limit_ && std::chrono::steady_clock::now() >= end_);
+  }
+
+private:
+  bool has_time_limit_{false};
+
+  std::chrono::steady_clock::time_point end_;
+
+};  // class Deadline
+
+}  // namespace TI4Cartographer
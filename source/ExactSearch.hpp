@@ -0,0 +1,480 @@
+#pragma once
+
+#include "BestBoard.hpp"
+#include "Bitboard.hpp"
+#include "Chronometre.hpp"
+#include "SearchCounters.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Exact branch-and-bound search. Fills the placement positions of a
+/// board one at a time with its selected systems while enforcing the placement
+/// rules, and abandons any partial board whose bound on the score imbalance
+/// cannot improve on the best board found so far. Once the search completes,
+/// the best board is provably optimal for the selected systems. This is only
+/// practical for small board layouts. Score imbalances are only compared to the
+/// precision at which they are printed. The search stops early if the time
+/// limit is reached or a stop is requested, in which case the best board is not
+/// proven to be optimal.
+/// \details The board type is a template parameter so that the board can
+/// include this header and run this search on itself.
+template <typename Board>
+class ExactSearch {
+public:
+  explicit ExactSearch(Board& board) noexcept : board_(board) {}
+
+  template <bool Instrumented>
+  void run(const float score_imbalance_ratio_tolerance, BestBoard& best_board) {
+    const Chronometre chronometre;
+    initialize();
+    branch<Instrumented>(0, score_imbalance_ratio_tolerance, best_board);
+    board_.total_number_of_iterations_ += number_of_nodes_;
+    board_.total_number_of_valid_boards_ += number_of_leaves_;
+    if constexpr (Instrumented) {
+      board_.search_counters_.add_iterations(
+          number_of_nodes_, number_of_leaves_);
+    }
+    const std::string summary{
+        std::to_string(number_of_nodes_) + " nodes and "
+        + std::to_string(number_of_leaves_) + " valid game boards in "
+        + chronometre.print()};
+    if (is_stopped_) {
+      verbose_message(
+          "Stopped after exploring " + summary
+          + " because the time limit was reached or a stop was requested. The "
+            "best game board found so far is not proven to be optimal.");
+    } else if (best_board.empty()) {
+      verbose_message(
+          "No valid game board exists for the selected systems after "
+          "exploring "
+          + summary + ".");
+    } else {
+      verbose_message(
+          "Found a provably optimal game board for the selected systems with "
+          "a score imbalance of "
+          + score_imbalance_ratio_to_string(best_board.score_imbalance_ratio())
+          + " after exploring " + summary + ".");
+    }
+  }
+
+private:
+  /// \brief Two score imbalances that differ by less than this are considered
+  /// to be equal, which is the precision at which they are printed. Without
+  /// it, proving that no board beats a board whose score imbalance is a tiny
+  /// fraction of a percent would require exploring almost every board.
+  static constexpr const float score_imbalance_ratio_resolution_{1.0e-4f};
+
+  /// \brief Selected systems that the search treats as one, because they are
+  /// interchangeable with respect to every placement rule, every validity
+  /// check, and every scoring term. Only the first remaining system of a class
+  /// is ever placed, so that the search does not enumerate boards that only
+  /// differ by a permutation of interchangeable systems.
+  struct SystemClass {
+    std::vector<SystemIndex> systems;
+
+    uint8_t number_of_remaining_systems{0};
+
+    bool is_equidistant{false};
+
+    uint8_t flags{0};
+
+    float system_score{0.0f};
+
+    float expansion_score{0.0f};
+
+    float planets{0.0f};
+
+    float pathway_score{0.0f};
+  };
+
+  Board& board_;
+
+  std::vector<SystemClass> system_classes_;
+
+  /// \brief Order in which the search fills the placement positions.
+  std::vector<uint8_t> placement_order_;
+
+  /// \brief Score of each player, indexed by player, from the linear terms of
+  /// the systems placed so far.
+  std::array<float, 9> player_scores_{};
+
+  /// \brief Reusable buffers of the score bounds. The weights are indexed by
+  /// player, then by feature: system score, expansion score, and planets.
+  std::array<std::array<std::vector<float>, 3>, 9> weights_;
+
+  std::array<std::vector<float>, 3> values_;
+
+  /// \brief Class of a unique system that the search only places on the first
+  /// placement position of each orbit under the symmetries of the board
+  /// layout, or the number of classes if there is no such class. Any board can
+  /// be mapped by a symmetry onto a board with the same score imbalance in
+  /// which this system is on such a position, so the other boards can be
+  /// skipped.
+  std::size_t symmetry_class_index_{0};
+
+  /// \brief Number of empty orbit representative positions that the system of
+  /// the symmetry class can still go to.
+  std::size_t number_of_open_representatives_{0};
+
+  uint64_t number_of_nodes_{0};
+
+  uint64_t number_of_leaves_{0};
+
+  bool is_stopped_{false};
+
+  /// \brief Groups the selected systems into classes of interchangeable
+  /// systems and orders the placement positions so that the positions that
+  /// weigh the most on the player scores are filled first.
+  void initialize() noexcept {
+    system_classes_.clear();
+    const auto add{[this](const SystemIndex system, const bool is_equidistant) {
+      const SystemClass candidate{
+          {system},
+          1,
+          is_equidistant,
+          Board::placement_flags(system),
+          Catalog.score(system),
+          Catalog.expansion_score(system),
+          static_cast<float>((Catalog.flags(system) & SystemContainsPlanets)
+                             != 0),
+          Board::pathway_score(system)};
+      for (SystemClass& system_class : system_classes_) {
+        const SystemIndex other{system_class.systems.front()};
+        if (system_class.is_equidistant == is_equidistant
+            && Catalog.flags(other) == Catalog.flags(system)
+            && Catalog.category(other) == Catalog.category(system)
+            && Catalog.score(other) == Catalog.score(system)
+            && Catalog.expansion_score(other) == Catalog.expansion_score(system)
+            && Catalog.number_of_planets(other)
+                   == Catalog.number_of_planets(system)
+            && Catalog.useful_resources(other)
+                   == Catalog.useful_resources(system)
+            && Catalog.useful_influence(other)
+                   == Catalog.useful_influence(system)) {
+          system_class.systems.push_back(system);
+          ++system_class.number_of_remaining_systems;
+          return;
+        }
+      }
+      system_classes_.push_back(candidate);
+    }};
+    for (const SystemIndex system : board_.selected_system_ids_.equidistant()) {
+      add(system, true);
+    }
+    for (const SystemIndex system : board_.selected_system_ids_.in_slice()) {
+      add(system, false);
+    }
+    // Try the best systems first so that good boards are found early, which
+    // tightens the pruning.
+    std::stable_sort(
+        system_classes_.begin(), system_classes_.end(),
+        [](const SystemClass& class_1, const SystemClass& class_2) {
+          return class_1.system_score > class_2.system_score;
+        });
+    const std::size_t number_of_positions{board_.placement_positions_.size()};
+    std::vector<float> total_weights(number_of_positions, 0.0f);
+    placement_order_.clear();
+    for (std::size_t index = 0; index < number_of_positions; ++index) {
+      for (const typename Board::PlacementScoreWeight& weight :
+           board_.placement_score_weights_[index]) {
+        total_weights[index] += weight.system;
+      }
+      placement_order_.push_back(static_cast<uint8_t>(index));
+    }
+    std::stable_sort(
+        placement_order_.begin(), placement_order_.end(),
+        [&total_weights](const uint8_t index_1, const uint8_t index_2) {
+          return total_weights[index_1] > total_weights[index_2];
+        });
+    symmetry_class_index_ = system_classes_.size();
+    number_of_open_representatives_ = 0;
+    if (board_.automorphisms_.size() > 1) {
+      for (std::size_t class_index = 0; class_index < system_classes_.size();
+           ++class_index) {
+        if (system_classes_[class_index].systems.size() == 1) {
+          symmetry_class_index_ = class_index;
+          break;
+        }
+      }
+      if (symmetry_class_index_ < system_classes_.size()) {
+        for (std::size_t index = 0; index < number_of_positions; ++index) {
+          if (board_.placement_is_orbit_representative_[index]
+              && board_.placement_is_equidistant_[index]
+                     == system_classes_[symmetry_class_index_]
+                            .is_equidistant) {
+            ++number_of_open_representatives_;
+          }
+        }
+        verbose_message(
+            "The exact search skips the boards that are equivalent by one of "
+            "the "
+            + std::to_string(board_.automorphisms_.size())
+            + " symmetries of the board layout.");
+      }
+    }
+    std::fill(board_.placed_flags_.begin(), board_.placed_flags_.end(), 0);
+    std::fill(board_.placed_systems_.begin(), board_.placed_systems_.end(),
+              NoSystemIndex);
+    board_.placed_wormholes_adjacent_to_homes_.fill(0);
+    board_.placed_supernova_bitboard_.clear();
+    // The systems containing planets adjacent to home term is two times the
+    // number of such systems minus two, which starts each player at -4.
+    player_scores_.fill(-4.0f);
+    number_of_nodes_ = 0;
+    number_of_leaves_ = 0;
+    is_stopped_ = false;
+  }
+
+  /// \brief Fills the placement position at the given depth with each class
+  /// of remaining systems in turn.
+  template <bool Instrumented>
+  void branch(const std::size_t depth,
+              const float score_imbalance_ratio_tolerance,
+              BestBoard& best_board) {
+    ++number_of_nodes_;
+    if ((number_of_nodes_ & Board::deadline_check_mask_) == 0
+        && board_.deadline_.expired()) {
+      is_stopped_ = true;
+    }
+    if (is_stopped_) {
+      return;
+    }
+    if (depth == placement_order_.size()) {
+      evaluate_leaf<Instrumented>(score_imbalance_ratio_tolerance, best_board);
+      return;
+    }
+    if (score_imbalance_ratio_bound(depth) + score_imbalance_ratio_resolution_
+        > best_board.score_imbalance_ratio()) {
+      return;
+    }
+    const uint8_t index{placement_order_[depth]};
+    const bool is_equidistant{board_.placement_is_equidistant_[index]};
+    // Whether this position is an open orbit representative position for the
+    // system of the symmetry class.
+    const bool is_open_representative{
+        symmetry_class_index_ < system_classes_.size()
+        && board_.placement_is_orbit_representative_[index]
+        && system_classes_[symmetry_class_index_].is_equidistant
+               == is_equidistant};
+    for (std::size_t class_index = 0; class_index < system_classes_.size();
+         ++class_index) {
+      SystemClass& system_class{system_classes_[class_index]};
+      if (system_class.is_equidistant != is_equidistant
+          || system_class.number_of_remaining_systems == 0
+          || !board_.can_place(index, system_class.flags)) {
+        continue;
+      }
+      if (class_index == symmetry_class_index_) {
+        if (!board_.placement_is_orbit_representative_[index]) {
+          continue;
+        }
+      } else if (
+          is_open_representative && number_of_open_representatives_ == 1
+          && system_classes_[symmetry_class_index_].number_of_remaining_systems
+                 > 0) {
+        // Leave the last orbit representative position to the system of the
+        // symmetry class.
+        continue;
+      }
+      if (is_open_representative) {
+        --number_of_open_representatives_;
+      }
+      --system_class.number_of_remaining_systems;
+      board_.placed_systems_[index] =
+          system_class.systems[system_class.number_of_remaining_systems];
+      board_.placed_flags_[index] = system_class.flags;
+      board_.update_placement_counts(index, system_class.flags, 1);
+      update_player_scores(index, system_class, 1.0f);
+      branch<Instrumented>(
+          depth + 1, score_imbalance_ratio_tolerance, best_board);
+      update_player_scores(index, system_class, -1.0f);
+      board_.update_placement_counts(index, system_class.flags, -1);
+      board_.placed_flags_[index] = 0;
+      board_.placed_systems_[index] = NoSystemIndex;
+      ++system_class.number_of_remaining_systems;
+      if (is_open_representative) {
+        ++number_of_open_representatives_;
+      }
+      if (is_stopped_) {
+        return;
+      }
+    }
+  }
+
+  /// \brief Adds (sign of 1) or removes (sign of -1) the linear terms of a
+  /// system placed on a placement position.
+  void update_player_scores(const uint8_t index,
+                            const SystemClass& system_class,
+                            const float sign) noexcept {
+    for (const typename Board::PlacementScoreWeight& weight :
+         board_.placement_score_weights_[index]) {
+      player_scores_[static_cast<uint8_t>(weight.player)] +=
+          sign
+          * (weight.system * system_class.system_score
+             + weight.expansion * system_class.expansion_score
+             + weight.planets * system_class.planets);
+    }
+  }
+
+  /// \brief Checks and scores a complete board. The placement rules already
+  /// hold, so only the planets, resources, and influence requirements remain
+  /// to be checked.
+  template <bool Instrumented>
+  void evaluate_leaf(const float score_imbalance_ratio_tolerance,
+                     BestBoard& best_board) {
+    for (uint8_t index = 0; index < board_.placement_positions_.size();
+         ++index) {
+      board_.positions_to_tiles_.find(board_.placement_ordinals_[index])
+          ->set_system_index(board_.placed_systems_[index]);
+      board_.update_system_bitboards(index, board_.placed_flags_[index]);
+    }
+    if (!board_.template passes<Instrumented>(
+            ValidityCheck::EnoughPlanets,
+            [this]() { return board_.players_have_enough_planets(); })
+        || !board_.template passes<Instrumented>(
+            ValidityCheck::EnoughUsefulResourcesAndUsefulInfluence,
+            [this]() {
+              return board_
+                  .players_have_enough_useful_resources_and_useful_influence();
+            })) {
+      return;
+    }
+    ++number_of_leaves_;
+    board_.template calculate_player_scores<Instrumented>();
+    board_.score_imbalance_ratio_ = board_.score_imbalance_ratio();
+    if (board_.score_imbalance_ratio_ < best_board.score_imbalance_ratio()) {
+      board_.update_best_board_and_return_success(
+          score_imbalance_ratio_tolerance, best_board, number_of_nodes_);
+    }
+  }
+
+  /// \brief Lower bound on the score imbalance of any board that completes
+  /// the partial board. Each player's final score lies between a lower and an
+  /// upper bound. For the linear terms, the remaining systems are matched to
+  /// the remaining positions of each player by the rearrangement inequality,
+  /// separately for each feature. For the pathway term, the remaining
+  /// positions take the worst or the best pathway score of the remaining
+  /// systems. The score imbalance is at least half the gap between the highest
+  /// lower bound and the lowest upper bound, divided by the highest possible
+  /// average score.
+  float score_imbalance_ratio_bound(const std::size_t depth) noexcept {
+    std::array<float, 9> lower_scores{player_scores_};
+    std::array<float, 9> upper_scores{player_scores_};
+    std::array<float, 64> lower_pathway_scores{};
+    std::array<float, 64> upper_pathway_scores{};
+    for (const bool is_equidistant : {true, false}) {
+      for (std::vector<float>& values : values_) {
+        values.clear();
+      }
+      float lowest_pathway_score{0.0f};
+      float highest_pathway_score{std::numeric_limits<float>::lowest()};
+      for (const SystemClass& system_class : system_classes_) {
+        if (system_class.is_equidistant != is_equidistant) {
+          continue;
+        }
+        for (uint8_t counter = 0;
+             counter < system_class.number_of_remaining_systems; ++counter) {
+          values_[0].push_back(system_class.system_score);
+          values_[1].push_back(system_class.expansion_score);
+          values_[2].push_back(system_class.planets);
+        }
+        if (system_class.number_of_remaining_systems > 0) {
+          lowest_pathway_score =
+              std::min(lowest_pathway_score, system_class.pathway_score);
+          highest_pathway_score =
+              std::max(highest_pathway_score, system_class.pathway_score);
+        }
+      }
+      if (values_[0].empty()) {
+        continue;
+      }
+      for (std::vector<float>& values : values_) {
+        std::sort(values.begin(), values.end());
+      }
+      for (const Player player : board_.players_) {
+        for (std::vector<float>& weights :
+             weights_[static_cast<uint8_t>(player)]) {
+          weights.clear();
+        }
+      }
+      for (std::size_t remaining = depth; remaining < placement_order_.size();
+           ++remaining) {
+        const uint8_t index{placement_order_[remaining]};
+        if (board_.placement_is_equidistant_[index] != is_equidistant) {
+          continue;
+        }
+        for (const typename Board::PlacementScoreWeight& weight :
+             board_.placement_score_weights_[index]) {
+          std::array<std::vector<float>, 3>& weights{
+              weights_[static_cast<uint8_t>(weight.player)]};
+          weights[0].push_back(weight.system);
+          weights[1].push_back(weight.expansion);
+          weights[2].push_back(weight.planets);
+        }
+        lower_pathway_scores[board_.placement_ordinals_[index]] =
+            lowest_pathway_score;
+        upper_pathway_scores[board_.placement_ordinals_[index]] =
+            highest_pathway_score;
+      }
+      const std::size_t number_of_values{values_[0].size()};
+      for (const Player player : board_.players_) {
+        const uint8_t player_index{static_cast<uint8_t>(player)};
+        for (uint8_t feature = 0; feature < 3; ++feature) {
+          std::vector<float>& weights{weights_[player_index][feature]};
+          std::sort(weights.begin(), weights.end(), std::greater<float>());
+          const std::vector<float>& values{values_[feature]};
+          for (std::size_t rank = 0; rank < weights.size(); ++rank) {
+            lower_scores[player_index] += weights[rank] * values[rank];
+            upper_scores[player_index] +=
+                weights[rank] * values[number_of_values - 1 - rank];
+          }
+        }
+      }
+    }
+    for (const Bitboard& layer : board_.pathway_layer_bitboards_) {
+      Bitboard remaining{layer};
+      while (!remaining.empty()) {
+        const uint8_t ordinal{remaining.pop_front()};
+        const uint8_t index{board_.placement_indices_[ordinal]};
+        if (index == Board::NoPlacementIndex) {
+          lower_pathway_scores[ordinal] = Board::pathway_score(
+              board_.positions_to_tiles_.find(ordinal)->system_index());
+          upper_pathway_scores[ordinal] = lower_pathway_scores[ordinal];
+        } else if (board_.placed_systems_[index] != NoSystemIndex) {
+          lower_pathway_scores[ordinal] =
+              Board::pathway_score(board_.placed_systems_[index]);
+          upper_pathway_scores[ordinal] = lower_pathway_scores[ordinal];
+        }
+      }
+    }
+    const std::array<float, 64> lower_best_scores{
+        board_.best_scores_to_mecatol_rex(lower_pathway_scores)};
+    const std::array<float, 64> upper_best_scores{
+        board_.best_scores_to_mecatol_rex(upper_pathway_scores)};
+    float highest_lower_score{std::numeric_limits<float>::lowest()};
+    float lowest_upper_score{std::numeric_limits<float>::max()};
+    float total_upper_score{0.0f};
+    for (const Player player : board_.players_) {
+      const uint8_t player_index{static_cast<uint8_t>(player)};
+      if (!board_.pathway_start_bitboards_[player_index].empty()) {
+        lower_scores[player_index] +=
+            board_.best_pathway_score(player, lower_best_scores);
+        upper_scores[player_index] +=
+            board_.best_pathway_score(player, upper_best_scores);
+      }
+      highest_lower_score =
+          std::max(highest_lower_score, lower_scores[player_index]);
+      lowest_upper_score =
+          std::min(lowest_upper_score, upper_scores[player_index]);
+      total_upper_score += upper_scores[player_index];
+    }
+    if (total_upper_score <= 0.0f
+        || highest_lower_score <= lowest_upper_score) {
+      return 0.0f;
+    }
+    return 0.5f * (highest_lower_score - lowest_upper_score)
+           * static_cast<float>(board_.players_.size()) / total_upper_score;
+  }
+};  // class ExactSearch
+
+}  // namespace TI4Cartographer
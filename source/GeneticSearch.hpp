@@ -0,0 +1,288 @@
+#pragma once
+
+#include "BestBoard.hpp"
+#include "SearchCounters.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Genetic algorithm. Keeps a population of arrangements of the
+/// selected systems of a board. Each generation keeps the fittest arrangements
+/// unchanged and replaces the others by children of parents chosen by
+/// tournament. A child takes the equidistant systems and the in-slice systems
+/// of its parents by order crossover, which always yields a permutation, and
+/// is then mutated by a swap with some probability. The fitness of an
+/// arrangement is its score imbalance plus a penalty for each validity check
+/// that it fails, so that invalid arrangements still pass on their systems
+/// while valid arrangements are preferred. The fitness of each generation is
+/// evaluated in parallel, with one copy of the board per thread.
+/// \details The board type is a template parameter so that the board can
+/// include this header and run this search on itself.
+template <typename Board>
+class GeneticSearch {
+public:
+  explicit GeneticSearch(Board& board) noexcept : board_(board) {}
+
+  template <bool Instrumented>
+  void run(const float score_imbalance_ratio_tolerance, BestBoard& best_board) {
+    std::vector<Board> evaluators(
+        std::max<std::size_t>(board_.number_of_threads_, 1), board_);
+    for (Board& evaluator : evaluators) {
+      evaluator.total_number_of_iterations_ = 0;
+      evaluator.total_number_of_valid_boards_ = 0;
+      evaluator.search_counters_ = {};
+    }
+    for (std::size_t group = 0; group < groups_.size(); ++group) {
+      groups_[group] = group == 0 ?
+                           board_.shuffled_equidistant_placement_indices_ :
+                           board_.shuffled_in_slice_placement_indices_;
+      std::sort(groups_[group].begin(), groups_[group].end());
+    }
+    taken_systems_.assign(Catalog.size(), 0);
+    population_.resize(population_size_);
+    offspring_.resize(population_size_);
+    for (Individual& individual : population_) {
+      board_.shuffle_selected_system_ids();
+      board_.template place_system_ids_on_tiles<Instrumented>();
+      individual.systems = board_.placement_system_indices();
+    }
+    evaluate_in_parallel<Instrumented>(evaluators, population_, 0, 0,
+                                       score_imbalance_ratio_tolerance,
+                                       best_board);
+    uint64_t number_of_generations{0};
+    bool success{false};
+    bool stopped_by_deadline{false};
+    while (true) {
+      if (best_board.score_imbalance_ratio()
+          <= score_imbalance_ratio_tolerance) {
+        success = true;
+        break;
+      }
+      if ((number_of_generations + 2) * population_size_
+          > Board::maximum_number_of_iterations_per_attempt_) {
+        break;
+      }
+      if (board_.deadline_.expired()) {
+        stopped_by_deadline = true;
+        break;
+      }
+      ++number_of_generations;
+      std::sort(population_.begin(), population_.end(),
+                [](const Individual& first, const Individual& second) {
+                  return first.fitness < second.fitness;
+                });
+      for (std::size_t index = 0; index < elite_size_; ++index) {
+        offspring_[index] = population_[index];
+      }
+      for (std::size_t index = elite_size_; index < population_size_;
+           ++index) {
+        std::vector<SystemIndex>& child{offspring_[index].systems};
+        const std::vector<SystemIndex>& first_parent{tournament().systems};
+        const std::vector<SystemIndex>& second_parent{tournament().systems};
+        child = first_parent;
+        for (const std::vector<uint8_t>& group : groups_) {
+          order_crossover(group, first_parent, second_parent, child);
+        }
+        if (board_.random_engine_.uniform() < mutation_probability_) {
+          const std::pair<uint8_t, uint8_t> indices{board_.random_swap()};
+          std::swap(child[indices.first], child[indices.second]);
+        }
+      }
+      evaluate_in_parallel<Instrumented>(
+          evaluators, offspring_, elite_size_,
+          number_of_generations * population_size_,
+          score_imbalance_ratio_tolerance, best_board);
+      std::swap(population_, offspring_);
+    }
+    uint64_t number_of_iterations{0};
+    uint64_t number_of_valid_boards{0};
+    for (const Board& evaluator : evaluators) {
+      number_of_iterations += evaluator.total_number_of_iterations_;
+      number_of_valid_boards += evaluator.total_number_of_valid_boards_;
+      board_.search_counters_ += evaluator.search_counters_;
+    }
+    board_.total_number_of_iterations_ += number_of_iterations;
+    board_.total_number_of_valid_boards_ += number_of_valid_boards;
+    if constexpr (Instrumented) {
+      board_.search_counters_.add_iterations(
+          number_of_iterations, number_of_valid_boards);
+    }
+    // Message after iterations are complete.
+    const std::string summary{
+        std::to_string(number_of_generations) + " generations which evaluated "
+        + std::to_string(number_of_iterations) + " game boards, of which "
+        + std::to_string(number_of_valid_boards) + " were valid"};
+    if (success) {
+      verbose_message("Found an optimal game board after " + summary + ".");
+    } else if (stopped_by_deadline) {
+      verbose_message("Stopped after " + summary
+                      + " because the time limit was reached or a stop was "
+                        "requested.");
+    } else {
+      verbose_message(
+          "No optimal game board with a score imbalance of "
+          + score_imbalance_ratio_to_string(score_imbalance_ratio_tolerance)
+          + " or less could be found after " + summary + ".");
+    }
+  }
+
+private:
+  /// \brief Number of individuals of the population.
+  static constexpr const std::size_t population_size_{64};
+
+  /// \brief Number of the fittest individuals that are kept unchanged from one
+  /// generation to the next.
+  static constexpr const std::size_t elite_size_{2};
+
+  /// \brief Number of individuals among which each parent is chosen.
+  static constexpr const uint8_t tournament_size_{3};
+
+  /// \brief Probability that a child is mutated by swapping the systems of two
+  /// of its positions.
+  static constexpr const float mutation_probability_{0.5};
+
+  /// \brief Penalty added to the fitness of an individual for each validity
+  /// check that it fails. It is much larger than any score imbalance, so that
+  /// any valid individual is fitter than any invalid one.
+  static constexpr const float validity_penalty_{1.0};
+
+  /// \brief Arrangement of the selected systems, as the system index of each
+  /// placement position, and its fitness. Lower is fitter.
+  struct Individual {
+    std::vector<SystemIndex> systems;
+
+    float fitness{0.0f};
+  };
+
+  Board& board_;
+
+  std::vector<Individual> population_;
+
+  /// \brief Reusable buffer of the next generation.
+  std::vector<Individual> offspring_;
+
+  /// \brief Sorted placement indices of the equidistant positions and of the
+  /// in-slice positions. Systems are only exchanged within each of these
+  /// groups.
+  std::array<std::vector<uint8_t>, 2> groups_;
+
+  /// \brief Reusable buffer of the systems that the order crossover has
+  /// already given to a child, indexed by system index.
+  std::vector<uint8_t> taken_systems_;
+
+  /// \brief Returns the fittest of a few randomly-chosen individuals of the
+  /// population.
+  const Individual& tournament() noexcept {
+    const Individual* winner{nullptr};
+    for (uint8_t counter = 0; counter < tournament_size_; ++counter) {
+      const Individual& contestant{population_[board_.random_engine_.below(
+          static_cast<uint32_t>(population_.size()))]};
+      if (winner == nullptr || contestant.fitness < winner->fitness) {
+        winner = &contestant;
+      }
+    }
+    return *winner;
+  }
+
+  /// \brief Order crossover of the systems of one group of placement
+  /// positions. The child keeps the systems of the first parent on a random
+  /// run of the group's positions, and receives the other systems in the order
+  /// in which they appear in the second parent, starting after the run and
+  /// wrapping around. The child must start as a copy of the first parent.
+  void order_crossover(const std::vector<uint8_t>& group,
+                       const std::vector<SystemIndex>& first_parent,
+                       const std::vector<SystemIndex>& second_parent,
+                       std::vector<SystemIndex>& child) noexcept {
+    const std::size_t size{group.size()};
+    if (size < 2) {
+      return;
+    }
+    std::size_t start{board_.random_engine_.below(static_cast<uint32_t>(size))};
+    std::size_t end{board_.random_engine_.below(static_cast<uint32_t>(size))};
+    if (start > end) {
+      std::swap(start, end);
+    }
+    ++end;
+    for (std::size_t offset = start; offset < end; ++offset) {
+      taken_systems_[first_parent[group[offset]]] = 1;
+    }
+    std::size_t destination{end % size};
+    for (std::size_t counter = 0; counter < size; ++counter) {
+      const SystemIndex system{second_parent[group[(end + counter) % size]]};
+      if (taken_systems_[system] == 0) {
+        child[group[destination]] = system;
+        destination = (destination + 1) % size;
+      }
+    }
+    for (std::size_t offset = start; offset < end; ++offset) {
+      taken_systems_[first_parent[group[offset]]] = 0;
+    }
+  }
+
+  /// \brief Evaluates the fitness of the individuals from the given index
+  /// onwards, spread over the evaluators, which each run on their own thread.
+  template <bool Instrumented>
+  void evaluate_in_parallel(std::vector<Board>& evaluators,
+                            std::vector<Individual>& individuals,
+                            const std::size_t first_index,
+                            const uint64_t number_of_iterations,
+                            const float score_imbalance_ratio_tolerance,
+                            BestBoard& best_board) {
+    const auto run_evaluator{[&](const std::size_t evaluator_index) {
+      for (std::size_t index = first_index + evaluator_index;
+           index < individuals.size(); index += evaluators.size()) {
+        evaluate_individual<Instrumented>(
+            evaluators[evaluator_index], individuals[index],
+            number_of_iterations + index + 1, score_imbalance_ratio_tolerance,
+            best_board);
+      }
+    }};
+    if (evaluators.size() == 1) {
+      run_evaluator(0);
+      return;
+    }
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < evaluators.size(); ++index) {
+      threads.emplace_back(run_evaluator, index);
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  /// \brief Places the systems of an individual on the tiles of the given
+  /// evaluator and evaluates its fitness. Records it as the best board if it
+  /// is valid and better than the best board found so far.
+  template <bool Instrumented>
+  void evaluate_individual(Board& evaluator, Individual& individual,
+                           const uint64_t number_of_iterations,
+                           const float score_imbalance_ratio_tolerance,
+                           BestBoard& best_board) {
+    evaluator.set_placement_system_indices(individual.systems);
+    for (uint8_t index = 0; index < evaluator.placement_positions_.size();
+         ++index) {
+      evaluator.update_system_bitboards(
+          index, Board::placement_flags(individual.systems[index]));
+    }
+    const uint8_t number_of_failed_checks{
+        evaluator.template number_of_failed_validity_checks<Instrumented>()};
+    evaluator.template calculate_player_scores<Instrumented>();
+    evaluator.score_imbalance_ratio_ = evaluator.score_imbalance_ratio();
+    individual.fitness =
+        evaluator.score_imbalance_ratio_
+        + validity_penalty_ * static_cast<float>(number_of_failed_checks);
+    ++evaluator.total_number_of_iterations_;
+    if (number_of_failed_checks == 0) {
+      ++evaluator.total_number_of_valid_boards_;
+    }
+    if ((number_of_failed_checks == 0
+         && evaluator.score_imbalance_ratio_
+                < best_board.score_imbalance_ratio())
+        || best_board.empty()) {
+      evaluator.update_best_board_and_return_success(
+          score_imbalance_ratio_tolerance, best_board, number_of_iterations,
+          number_of_failed_checks == 0);
+    }
+  }
+};  // class GeneticSearch
+
+}  // namespace TI4Cartographer
@@ -1,23 +1,34 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
 #include <cctype>
 #include <chrono>
 #include <climits>
 #include <cmath>
+#include <condition_variable>
+#include <csignal>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <random>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
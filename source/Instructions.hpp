@@ -1,8 +1,7 @@
 #pragma once
 
-#include "Aggression.hpp"
-#include "GameVersion.hpp"
-#include "Layout.hpp"
+#include "RandomStreams.hpp"
+#include "Settings.hpp"
 
 namespace TI4Cartographer {
 
@@ -11,6 +10,8 @@ namespace Arguments {
 
 const std::string QuietMode{"--quiet"};
 
+const std::string StatsMode{"--stats"};
+
 const std::string UsageInformation{"--help"};
 
 const std::string NumberOfPlayersKey{"--players"};
@@ -29,6 +30,39 @@ const std::string GameVersionKey{"--version"};
 
 const std::string GameVersionPattern{GameVersionKey + " <type>"};
 
+const std::string SearchKey{"--search"};
+
+const std::string SearchPattern{SearchKey + " <type>"};
+
+const std::string SeedKey{"--seed"};
+
+const std::string SeedPattern{SeedKey + " <number>"};
+
+const std::string NumberOfBoardsKey{"--count"};
+
+const std::string NumberOfBoardsPattern{NumberOfBoardsKey + " <number>"};
+
+const std::string NumberOfOptionsKey{"--top"};
+
+const std::string NumberOfOptionsPattern{NumberOfOptionsKey + " <number>"};
+
+const std::string MinimumOptionDistanceKey{"--min-distance"};
+
+const std::string MinimumOptionDistancePattern{
+    MinimumOptionDistanceKey + " <number>"};
+
+const std::string TimeLimitKey{"--time-limit-ms"};
+
+const std::string TimeLimitPattern{TimeLimitKey + " <number>"};
+
+const std::string NumberOfThreadsKey{"--threads"};
+
+const std::string NumberOfThreadsPattern{NumberOfThreadsKey + " <number>"};
+
+const std::string ServeKey{"--serve"};
+
+const std::string ServePattern{ServeKey + " <path>"};
+
 }  // namespace Arguments
 
 /// \brief Parser and organizer of the program's command-line arguments.
@@ -42,16 +76,18 @@ public:
     check_layout_and_game_version();
   }
 
-  Layout layout() const noexcept {
-    return layout_;
+  const Settings& settings() const noexcept {
+    return settings_;
   }
 
-  Aggression aggression() const noexcept {
-    return aggression_;
+  /// \brief True if the program runs as a server instead of generating boards
+  /// directly.
+  bool serve() const noexcept {
+    return !socket_path_.empty();
   }
 
-  GameVersion game_version() const noexcept {
-    return game_version_;
+  const std::string& socket_path() const noexcept {
+    return socket_path_;
   }
 
 private:
@@ -59,12 +95,11 @@ private:
 
   std::vector<std::string> arguments_;
 
-  Layout layout_{Layout::Players6Regular};
+  Settings settings_;
 
-  Aggression aggression_{Aggression::Moderate};
+  bool seed_is_initialized_{false};
 
-  GameVersion game_version_{
-      GameVersion::ProphecyOfKingsAndThundersEdgeExpansions};
+  std::string socket_path_;
 
   void assign_arguments(int argc, char* argv[]) noexcept {
     if (argc > 1) {
@@ -90,6 +125,8 @@ private:
         argument < arguments_.cend(); ++argument) {
       if (*argument == Arguments::QuietMode) {
         Communicator::get().initialize(CommunicatorMode::Quiet);
+      } else if (*argument == Arguments::StatsMode) {
+        settings_.set_stats(true);
       } else if (*argument == Arguments::UsageInformation) {
         message_header_information();
         message_usage_information();
@@ -107,11 +144,39 @@ private:
       } else if (*argument == Arguments::GameVersionKey
                  && argument + 1 < arguments_.cend()) {
         initialize_game_version(*(argument + 1));
+      } else if (*argument == Arguments::SearchKey
+                 && argument + 1 < arguments_.cend()) {
+        initialize_search(*(argument + 1));
+      } else if (*argument == Arguments::SeedKey
+                 && argument + 1 < arguments_.cend()) {
+        initialize_seed(*(argument + 1));
+      } else if (*argument == Arguments::NumberOfBoardsKey
+                 && argument + 1 < arguments_.cend()) {
+        initialize_number_of_boards(*(argument + 1));
+      } else if (*argument == Arguments::NumberOfOptionsKey
+                 && argument + 1 < arguments_.cend()) {
+        initialize_number_of_options(*(argument + 1));
+      } else if (*argument == Arguments::MinimumOptionDistanceKey
+                 && argument + 1 < arguments_.cend()) {
+        initialize_minimum_option_distance(*(argument + 1));
+      } else if (*argument == Arguments::TimeLimitKey
+                 && argument + 1 < arguments_.cend()) {
+        initialize_time_limit(*(argument + 1));
+      } else if (*argument == Arguments::NumberOfThreadsKey
+                 && argument + 1 < arguments_.cend()) {
+        initialize_number_of_threads(*(argument + 1));
+      } else if (*argument == Arguments::ServeKey
+                 && argument + 1 < arguments_.cend()) {
+        initialize_socket_path(*(argument + 1));
       }
     }
     Communicator::get().initialize(CommunicatorMode::Verbose);
+    if (!seed_is_initialized_) {
+      settings_.set_seed(RandomStreams::random_seed());
+    }
     check_game_version(number_of_players);
     initialize_layout(number_of_players, layout_string);
+    check_minimum_option_distance();
   }
 
   void check_number_of_players(const uint8_t number_of_players) const {
@@ -123,7 +188,7 @@ private:
   void initialize_aggression(const std::string aggression) {
     const std::optional<Aggression> found{type<Aggression>(aggression)};
     if (found.has_value()) {
-      aggression_ = found.value();
+      settings_.set_aggression(found.value());
     } else {
       message_usage_information_and_error(
           "Unknown board aggression: " + aggression);
@@ -133,15 +198,106 @@ private:
   void initialize_game_version(const std::string game_version) {
     const std::optional<GameVersion> found{type<GameVersion>(game_version)};
     if (found.has_value()) {
-      game_version_ = found.value();
+      settings_.set_game_version(found.value());
     } else {
       message_usage_information_and_error(
           "Unknown game version: " + game_version);
     }
   }
 
+  void initialize_search(const std::string search) {
+    const std::optional<Search> found{type<Search>(search)};
+    if (found.has_value()) {
+      settings_.set_search(found.value());
+    } else {
+      message_usage_information_and_error("Unknown search engine: " + search);
+    }
+  }
+
+  void initialize_seed(const std::string& seed) {
+    if (seed.empty() || seed.front() == '-') {
+      message_usage_information_and_error("Invalid seed: " + seed);
+    }
+    settings_.set_seed(static_cast<uint64_t>(std::stoull(seed)));
+    seed_is_initialized_ = true;
+  }
+
+  void initialize_number_of_boards(const std::string& number_of_boards) {
+    const long long number{std::stoll(number_of_boards)};
+    if (number < 1 || number > std::numeric_limits<uint32_t>::max()) {
+      message_usage_information_and_error(
+          "Invalid number of boards: " + number_of_boards);
+    }
+    settings_.set_number_of_boards(static_cast<uint32_t>(number));
+  }
+
+  void initialize_number_of_options(const std::string& number_of_options) {
+    const long long number{std::stoll(number_of_options)};
+    if (number < 1 || number > std::numeric_limits<uint16_t>::max()) {
+      message_usage_information_and_error(
+          "Invalid number of options: " + number_of_options);
+    }
+    settings_.set_number_of_options(static_cast<uint16_t>(number));
+  }
+
+  void initialize_minimum_option_distance(
+      const std::string& minimum_option_distance) {
+    const long long number{std::stoll(minimum_option_distance)};
+    if (number < 1 || number > 64) {
+      message_usage_information_and_error(
+          "Invalid minimum distance: " + minimum_option_distance);
+    }
+    settings_.set_minimum_option_distance(static_cast<uint8_t>(number));
+  }
+
+  /// \brief Two boards differ in at most the number of placement positions of
+  /// the board layout. A larger minimum distance would make every pair of
+  /// boards near-duplicates, so that more than one option could never be kept.
+  void check_minimum_option_distance() const {
+    const uint8_t number_of_placement_positions{static_cast<uint8_t>(
+        number_of_systems(SystemCategory::Planetary, settings_.layout())
+        + number_of_systems(
+            SystemCategory::AnomalyWormholeEmpty, settings_.layout()))};
+    if (settings_.minimum_option_distance() > number_of_placement_positions) {
+      message_usage_information_and_error(
+          "The minimum distance must be at most "
+          + std::to_string(number_of_placement_positions) + " for the "
+          + label(settings_.layout()) + " board layout.");
+    }
+  }
+
+  void initialize_time_limit(const std::string& time_limit) {
+    if (time_limit.empty() || time_limit.front() == '-') {
+      message_usage_information_and_error("Invalid time limit: " + time_limit);
+    }
+    const unsigned long long milliseconds{std::stoull(time_limit)};
+    if (milliseconds == 0) {
+      message_usage_information_and_error("Invalid time limit: " + time_limit);
+    }
+    settings_.set_time_limit_milliseconds(static_cast<uint64_t>(milliseconds));
+  }
+
+  void initialize_number_of_threads(const std::string& number_of_threads) {
+    const int number{std::stoi(number_of_threads)};
+    if (number < 0 || number > std::numeric_limits<uint16_t>::max()) {
+      message_usage_information_and_error(
+          "Invalid number of threads: " + number_of_threads);
+    }
+    settings_.set_number_of_threads(static_cast<uint16_t>(number));
+  }
+
+  void initialize_socket_path(const std::string& socket_path) {
+    if (socket_path.empty() || socket_path.front() == '-') {
+      message_usage_information_and_error("Invalid socket path: " + socket_path);
+    }
+    socket_path_ = socket_path;
+    // A server only prints its own status messages.
+    Communicator::get().initialize(CommunicatorMode::Quiet);
+  }
+
   void check_game_version(const uint8_t number_of_players) const {
-    if (number_of_players >= 7 && game_version_ == GameVersion::BaseGame) {
+    if (number_of_players >= 7
+        && settings_.game_version() == GameVersion::BaseGame) {
       message_usage_information_and_error(
           "7 and 8 player games require the "
           + label(GameVersion::ProphecyOfKingsExpansion) + " or the "
@@ -156,7 +312,7 @@ private:
         + lowercase(remove_non_alphanumeric_characters(layout_string))};
     const std::optional<Layout> found{type<Layout>(label)};
     if (found.has_value()) {
-      layout_ = found.value();
+      settings_.set_layout(found.value());
     } else {
       message_usage_information_and_error(
           "Unknown board layout: " + layout_string);
@@ -180,13 +336,27 @@ private:
         space + executable_name_ + space + Arguments::NumberOfPlayersPattern
         + space + Arguments::LayoutPattern + space
         + Arguments::AggressionPattern + space + Arguments::GameVersionPattern
-        + space + Arguments::QuietMode);
+        + space + Arguments::SearchPattern + space
+        + Arguments::SeedPattern + space + Arguments::NumberOfBoardsPattern
+        + space + Arguments::NumberOfOptionsPattern + space
+        + Arguments::MinimumOptionDistancePattern + space
+        + Arguments::TimeLimitPattern + space
+        + Arguments::NumberOfThreadsPattern + space + Arguments::ServePattern
+        + space + Arguments::StatsMode + space + Arguments::QuietMode);
     const uint_least64_t length{std::max(
         {Arguments::UsageInformation.length(),
          Arguments::NumberOfPlayersPattern.length(),
          Arguments::LayoutPattern.length(),
          Arguments::AggressionPattern.length(),
          Arguments::GameVersionPattern.length(),
+         Arguments::SearchPattern.length(),
+         Arguments::SeedPattern.length(),
+         Arguments::NumberOfBoardsPattern.length(),
+         Arguments::NumberOfOptionsPattern.length(),
+         Arguments::MinimumOptionDistancePattern.length(),
+         Arguments::TimeLimitPattern.length(),
+         Arguments::NumberOfThreadsPattern.length(),
+         Arguments::ServePattern.length(), Arguments::StatsMode.length(),
          Arguments::QuietMode.length()})};
     verbose_message("Arguments:");
     verbose_message(space + pad_to_length(Arguments::UsageInformation, length)
@@ -204,6 +374,15 @@ private:
     verbose_message(space + space + "8 players: regular or large");
     verbose_message(space + pad_to_length(Arguments::AggressionPattern, length) + space + "Optional. Specifies the degree of expected aggression resulting from the placement of systems on the board. Choices are low, moderate, or high. The default is moderate. Higher aggression places better systems at equidistant positions compared to the systems in each player's slice, whereas lower aggression does the opposite.");
     verbose_message(space + pad_to_length(Arguments::GameVersionPattern, length) + space + "Optional. Determines whether the system tiles from the Prophecy of Kings expansion can be used. Choices are base or expansion. The default is expansion. Note that 7 and 8 player games require the Prophecy of Kings expansion.");
+    verbose_message(space + pad_to_length(Arguments::SearchPattern, length) + space + "Optional. Specifies the search engine used to find a balanced board. Choices are random, annealing, exact, partition, tempering, or genetic. The default is random. The random search generates each board independently of the previous ones, whereas the annealing search starts from a valid board and improves it by swapping pairs of equidistant systems or pairs of in-slice systems. The exact search uses branch and bound to find a provably optimal board for the selected systems, and is only practical for small board layouts. The partition search first splits the in-slice systems among the slices so that their scores are balanced, then arranges the systems within each slice. The tempering search runs one replica of the board per thread, at least 4, at different temperatures, and periodically exchanges the temperatures of neighboring replicas. The genetic search evolves a population of boards by crossover and mutation and scores each generation on all threads.");
+    verbose_message(space + pad_to_length(Arguments::SeedPattern, length) + space + "Optional. Specifies the seed from which all random numbers are derived, as a non-negative integer. Runs with the same seed, the same arguments, and a single thread generate the same boards. By default, a random seed is used, which is printed so that the run can be repeated.");
+    verbose_message(space + pad_to_length(Arguments::NumberOfBoardsPattern, length) + space + "Optional. Specifies the number of independent balanced boards to generate. The board layout is only initialized once, and the boards are generated one after another. In quiet mode, the Tabletop Simulator string of each board is printed on its own line. The default is 1.");
+    verbose_message(space + pad_to_length(Arguments::NumberOfOptionsPattern, length) + space + "Optional. Specifies the number of options to generate for each board. The search keeps the best valid boards that it finds, up to this number, and stops once all of them are sufficiently balanced. Each option is printed, best first. In quiet mode, the Tabletop Simulator string of each option is printed on its own line. The default is 1.");
+    verbose_message(space + pad_to_length(Arguments::MinimumOptionDistancePattern, length) + space + "Optional. Specifies the minimum number of positions in which any two options of the same board must differ. A board that differs from a better option in fewer positions is discarded as a near-duplicate. It must be at most the number of systems placed on the board layout. The default is 1, which only discards identical boards.");
+    verbose_message(space + pad_to_length(Arguments::TimeLimitPattern, length) + space + "Optional. Specifies the time limit of the generation of each board, in milliseconds. Once it is reached, the search stops and the best board found so far is used. By default, there is no time limit. Independently of this option, an interrupt or termination signal stops the search and prints the best board found so far.");
+    verbose_message(space + pad_to_length(Arguments::NumberOfThreadsPattern, length) + space + "Optional. Specifies the number of worker threads that generate boards in parallel. Each worker uses its own selection of systems, and all workers stop as soon as one of them finds a sufficiently balanced board. A value of 0 uses all available hardware threads. The default is 1.");
+    verbose_message(space + pad_to_length(Arguments::ServePattern, length) + space + "Optional. Runs a server that listens on a Unix domain socket at the given path instead of generating boards directly. The system catalog and every board layout are only initialized once. Each request is one line of arguments, such as \"--players 6 --layout regular --seed 42 --time-limit-ms 500\", and accepts the --players, --layout, --aggression, --version, --search, --seed, and --time-limit-ms arguments. Omitted arguments take the values given when starting the server. Each response is one line that contains either the generated board's Tabletop Simulator string or an error message that starts with \"error:\". Requests longer than 4096 characters are rejected with an error. Each request has a time limit of 10 seconds by default and at most 60 seconds. Each worker thread serves one client at a time. The server stops on an interrupt or termination signal.");
+    verbose_message(space + pad_to_length(Arguments::StatsMode, length) + space + "Optional. Activates statistics mode, where the search engines count how often each validity check rejects a board and measure the cumulative time spent in each validity check and each scoring term. The counters of each attempt are printed as JSON at exit. Without this option, the search engines run a separately compiled version that contains no instrumentation.");
     verbose_message(space + pad_to_length(Arguments::QuietMode, length) + space + "Optional. Activates quiet mode, where the only console output is the generated board's Tabletop Simulator string.");
     verbose_message("");
   }
@@ -217,16 +396,38 @@ private:
   }
 
   void message_start_information() const noexcept {
+    verbose_message("The number of players and board layout is: "
+                    + label(settings_.layout()));
+    verbose_message("The aggression is: " + label(settings_.aggression()));
+    verbose_message(
+        "The game version is: " + label(settings_.game_version()));
+    verbose_message("The search engine is: " + label(settings_.search()));
+    verbose_message("The seed is: " + std::to_string(settings_.seed()));
+    verbose_message("The number of boards is: "
+                    + std::to_string(settings_.number_of_boards()));
+    verbose_message("The number of options per board is: "
+                    + std::to_string(settings_.number_of_options()));
     verbose_message(
-        "The number of players and board layout is: " + label(layout_));
-    verbose_message("The aggression is: " + label(aggression_));
-    verbose_message("The game version is: " + label(game_version_));
+        "The minimum distance between options is: "
+        + std::to_string(settings_.minimum_option_distance()));
+    if (settings_.time_limit_milliseconds() > 0) {
+      verbose_message(
+          "The time limit is: "
+          + std::to_string(settings_.time_limit_milliseconds()) + " ms");
+    } else {
+      verbose_message("The time limit is: none");
+    }
+    verbose_message("The number of threads is: "
+                    + std::to_string(settings_.number_of_threads()));
+    verbose_message(std::string{"Statistics mode is: "}
+                    + (settings_.stats() ? "on" : "off"));
   }
 
   void check_layout_and_game_version() const {
-    if (!layout_and_game_version_are_compatible(layout_, game_version_)) {
+    if (!layout_and_game_version_are_compatible(
+            settings_.layout(), settings_.game_version())) {
       error("The board layout and the game version are incompatible. The "
-            + label(layout_) + " board layout requires the "
+            + label(settings_.layout()) + " board layout requires the "
             + label(GameVersion::ProphecyOfKingsExpansion) + " or the "
             + label(GameVersion::ThundersEdgeExpansion) + ".");
     }
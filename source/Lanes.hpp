@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Base.hpp"
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace TI4Cartographer {
+
+/// \brief Eight single-precision floats that are operated on together, one
+/// lane per candidate game board. Uses one AVX register when the compiler
+/// targets AVX, two SSE registers when it targets SSE2, and a plain loop
+/// otherwise. Every implementation gives the same results.
+class Lanes {
+public:
+  static constexpr const std::size_t size{8};
+
+  Lanes() noexcept : Lanes(0.0f) {}
+
+  /// \brief Sets every lane to the given value.
+  explicit Lanes(const float value) noexcept {
+#if defined(__AVX__)
+    values_ = _mm256_set1_ps(value);
+#elif defined(__SSE2__)
+    low_ = _mm_set1_ps(value);
+    high_ = _mm_set1_ps(value);
+#else
+    values_.fill(value);
+#endif
+  }
+
+  /// \brief Loads the lanes from eight contiguous floats.
+  static Lanes load(const float* values) noexcept {
+    Lanes lanes;
+#if defined(__AVX__)
+    lanes.values_ = _mm256_loadu_ps(values);
+#elif defined(__SSE2__)
+    lanes.low_ = _mm_loadu_ps(values);
+    lanes.high_ = _mm_loadu_ps(values + 4);
+#else
+    std::copy(values, values + size, lanes.values_.begin());
+#endif
+    return lanes;
+  }
+
+  /// \brief Stores the lanes to eight contiguous floats.
+  void store(float* values) const noexcept {
+#if defined(__AVX__)
+    _mm256_storeu_ps(values, values_);
+#elif defined(__SSE2__)
+    _mm_storeu_ps(values, low_);
+    _mm_storeu_ps(values + 4, high_);
+#else
+    std::copy(values_.cbegin(), values_.cend(), values);
+#endif
+  }
+
+  Lanes& operator+=(const Lanes& other) noexcept {
+    *this = *this + other;
+    return *this;
+  }
+
+  friend Lanes operator+(const Lanes& left, const Lanes& right) noexcept {
+#if defined(__AVX__)
+    return Lanes{_mm256_add_ps(left.values_, right.values_)};
+#elif defined(__SSE2__)
+    return Lanes{_mm_add_ps(left.low_, right.low_),
+                 _mm_add_ps(left.high_, right.high_)};
+#else
+    return apply(left, right, [](const float a, const float b) {
+      return a + b;
+    });
+#endif
+  }
+
+  friend Lanes operator-(const Lanes& left, const Lanes& right) noexcept {
+#if defined(__AVX__)
+    return Lanes{_mm256_sub_ps(left.values_, right.values_)};
+#elif defined(__SSE2__)
+    return Lanes{_mm_sub_ps(left.low_, right.low_),
+                 _mm_sub_ps(left.high_, right.high_)};
+#else
+    return apply(left, right, [](const float a, const float b) {
+      return a - b;
+    });
+#endif
+  }
+
+  friend Lanes operator*(const Lanes& left, const Lanes& right) noexcept {
+#if defined(__AVX__)
+    return Lanes{_mm256_mul_ps(left.values_, right.values_)};
+#elif defined(__SSE2__)
+    return Lanes{_mm_mul_ps(left.low_, right.low_),
+                 _mm_mul_ps(left.high_, right.high_)};
+#else
+    return apply(left, right, [](const float a, const float b) {
+      return a * b;
+    });
+#endif
+  }
+
+  friend Lanes operator/(const Lanes& left, const Lanes& right) noexcept {
+#if defined(__AVX__)
+    return Lanes{_mm256_div_ps(left.values_, right.values_)};
+#elif defined(__SSE2__)
+    return Lanes{_mm_div_ps(left.low_, right.low_),
+                 _mm_div_ps(left.high_, right.high_)};
+#else
+    return apply(left, right, [](const float a, const float b) {
+      return a / b;
+    });
+#endif
+  }
+
+  static Lanes max(const Lanes& left, const Lanes& right) noexcept {
+#if defined(__AVX__)
+    return Lanes{_mm256_max_ps(left.values_, right.values_)};
+#elif defined(__SSE2__)
+    return Lanes{_mm_max_ps(left.low_, right.low_),
+                 _mm_max_ps(left.high_, right.high_)};
+#else
+    return apply(left, right, [](const float a, const float b) {
+      return std::max(a, b);
+    });
+#endif
+  }
+
+  static Lanes min(const Lanes& left, const Lanes& right) noexcept {
+#if defined(__AVX__)
+    return Lanes{_mm256_min_ps(left.values_, right.values_)};
+#elif defined(__SSE2__)
+    return Lanes{_mm_min_ps(left.low_, right.low_),
+                 _mm_min_ps(left.high_, right.high_)};
+#else
+    return apply(left, right, [](const float a, const float b) {
+      return std::min(a, b);
+    });
+#endif
+  }
+
+private:
+#if defined(__AVX__)
+  explicit Lanes(const __m256 values) noexcept : values_(values) {}
+
+  __m256 values_;
+#elif defined(__SSE2__)
+  Lanes(const __m128 low, const __m128 high) noexcept
+    : low_(low), high_(high) {}
+
+  __m128 low_;
+
+  __m128 high_;
+#else
+  template <typename Operation>
+  static Lanes apply(const Lanes& left, const Lanes& right,
+                     const Operation& operation) noexcept {
+    Lanes lanes;
+    for (std::size_t lane = 0; lane < size; ++lane) {
+      lanes.values_[lane] = operation(left.values_[lane], right.values_[lane]);
+    }
+    return lanes;
+  }
+
+  std::array<float, size> values_;
+#endif
+
+};  // class Lanes
+
+}  // namespace TI4Cartographer
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "BestBoard.hpp"
+#include "SearchCounters.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Two-phase search. Balance mostly comes from which systems each
+/// player receives, and only secondarily from where they sit. Each iteration
+/// first partitions the in-slice systems of a board among the players' slices
+/// so that the sums of their scores are close, then places the systems of each
+/// slice within that slice and the equidistant systems on the equidistant
+/// positions, and finally improves this arrangement by swapping systems within
+/// a slice or within the equidistant positions. Only the first arrangement of
+/// each partition is scored in full; its swaps are scored incrementally.
+/// \details The board type is a template parameter so that the board can
+/// include this header and run this search on itself.
+template <typename Board>
+class PartitionSearch {
+public:
+  explicit PartitionSearch(Board& board) noexcept
+    : board_(board), system_slice_players_(Catalog.size(), 0) {}
+
+  template <bool Instrumented>
+  void run(const float score_imbalance_ratio_tolerance, BestBoard& best_board) {
+    uint64_t number_of_iterations{0};
+    uint64_t number_of_valid_boards{0};
+    bool success{false};
+    bool stopped_by_another_worker{false};
+    bool stopped_by_deadline{false};
+    for (uint64_t counter = 0;
+         counter < maximum_number_of_partitions_per_attempt_; ++counter) {
+      if (best_board.score_imbalance_ratio()
+          <= score_imbalance_ratio_tolerance) {
+        stopped_by_another_worker = true;
+        break;
+      }
+      if (board_.deadline_.expired()) {
+        stopped_by_deadline = true;
+        break;
+      }
+      ++number_of_iterations;
+      board_.shuffle_selected_system_ids();
+      partition_in_slice_systems();
+      if (!board_.template place_system_ids_on_tiles<Instrumented>()) {
+        continue;
+      }
+      ++number_of_valid_boards;
+      board_.initialize_incremental_player_scores();
+      float current_score_imbalance_ratio{board_.score_imbalance_ratio()};
+      for (uint32_t swap = 0; swap < arrangement_swaps_; ++swap) {
+        const std::optional<std::pair<uint8_t, uint8_t>> indices{
+            random_group_swap()};
+        if (!indices.has_value()) {
+          break;
+        }
+        board_.template swap_system_ids_and_update_player_scores<Instrumented>(
+            indices->first, indices->second);
+        if (!board_.template iteration_is_valid<Instrumented>()) {
+          board_
+              .template swap_system_ids_and_update_player_scores<Instrumented>(
+                  indices->first, indices->second);
+          continue;
+        }
+        ++number_of_valid_boards;
+        const float score_imbalance_ratio{board_.score_imbalance_ratio()};
+        if (score_imbalance_ratio < current_score_imbalance_ratio) {
+          current_score_imbalance_ratio = score_imbalance_ratio;
+        } else {
+          board_
+              .template swap_system_ids_and_update_player_scores<Instrumented>(
+                  indices->first, indices->second);
+        }
+      }
+      if (current_score_imbalance_ratio < best_board.score_imbalance_ratio()) {
+        // Discard any floating-point drift of the incremental scorer.
+        board_.template calculate_player_scores<Instrumented>();
+        board_.score_imbalance_ratio_ = board_.score_imbalance_ratio();
+        success = board_.update_best_board_and_return_success(
+            score_imbalance_ratio_tolerance, best_board, number_of_iterations);
+        if (success) {
+          break;
+        }
+      }
+    }
+    board_.total_number_of_iterations_ += number_of_iterations;
+    board_.total_number_of_valid_boards_ += number_of_valid_boards;
+    if constexpr (Instrumented) {
+      board_.search_counters_.add_iterations(
+          number_of_iterations, number_of_valid_boards);
+    }
+    // Message after iterations are complete.
+    const std::string summary{
+        std::to_string(number_of_iterations)
+        + " partitions which generated "
+        + std::to_string(number_of_valid_boards) + " valid game boards"};
+    if (success) {
+      verbose_message("Found an optimal game board after " + summary + ".");
+    } else if (stopped_by_another_worker) {
+      verbose_message("Stopped after " + summary
+                      + " because another worker found an optimal game "
+                        "board.");
+    } else if (stopped_by_deadline) {
+      verbose_message("Stopped after " + summary
+                      + " because the time limit was reached or a stop was "
+                        "requested.");
+    } else {
+      verbose_message(
+          "No optimal game board with a score imbalance of "
+          + score_imbalance_ratio_to_string(score_imbalance_ratio_tolerance)
+          + " or less could be found after " + summary + ".");
+    }
+  }
+
+private:
+  /// \brief Maximum number of partitions of the in-slice systems that the
+  /// search tries during one attempt.
+  static constexpr const uint64_t maximum_number_of_partitions_per_attempt_{
+      20000};
+
+  /// \brief Maximum number of rounds of the refinement of each partition of
+  /// the in-slice systems.
+  static constexpr const uint8_t maximum_number_of_refinements_{64};
+
+  /// \brief Number of swaps with which the search arranges the systems of each
+  /// partition within their slices and within the equidistant positions.
+  static constexpr const uint32_t arrangement_swaps_{256};
+
+  Board& board_;
+
+  /// \brief In-slice systems given to the slice of each player, indexed by
+  /// player.
+  std::array<std::vector<SystemIndex>, 9> slices_;
+
+  /// \brief Sum of the scores of the in-slice systems given to the slice of
+  /// each player, indexed by player.
+  std::array<float, 9> scores_{};
+
+  /// \brief Player to whose slice each in-slice system is given, indexed by
+  /// system index.
+  std::vector<uint8_t> system_slice_players_;
+
+  /// \brief First phase of the search. Deals the shuffled in-slice systems
+  /// into the players' slices, then refines the partition: while a swap of
+  /// one system between the slice with the highest sum of scores and the slice
+  /// with the lowest sum of scores narrows the gap between them, the swap that
+  /// narrows it most is made. Finally, restricts each in-slice placement
+  /// candidate of the board to its slice.
+  void partition_in_slice_systems() noexcept {
+    for (const Player player : board_.players_) {
+      slices_[static_cast<uint8_t>(player)].clear();
+      scores_[static_cast<uint8_t>(player)] = 0.0f;
+    }
+    std::set<Player>::const_iterator player{board_.players_.cbegin()};
+    for (const SystemIndex system : board_.selected_system_ids_.in_slice()) {
+      while (slices_[static_cast<uint8_t>(*player)].size()
+             == board_.placement_group_indices_[static_cast<uint8_t>(*player)]
+                    .size()) {
+        ++player;
+      }
+      slices_[static_cast<uint8_t>(*player)].push_back(system);
+      scores_[static_cast<uint8_t>(*player)] += Catalog.score(system);
+    }
+    for (uint8_t round = 0; round < maximum_number_of_refinements_; ++round) {
+      uint8_t highest{static_cast<uint8_t>(*board_.players_.cbegin())};
+      uint8_t lowest{highest};
+      for (const Player other : board_.players_) {
+        const uint8_t other_index{static_cast<uint8_t>(other)};
+        if (scores_[other_index] > scores_[highest]) {
+          highest = other_index;
+        }
+        if (scores_[other_index] < scores_[lowest]) {
+          lowest = other_index;
+        }
+      }
+      const float gap{scores_[highest] - scores_[lowest]};
+      float best_gap{gap};
+      std::size_t best_highest_index{0};
+      std::size_t best_lowest_index{0};
+      for (std::size_t highest_index = 0;
+           highest_index < slices_[highest].size(); ++highest_index) {
+        for (std::size_t lowest_index = 0;
+             lowest_index < slices_[lowest].size(); ++lowest_index) {
+          const float difference{
+              Catalog.score(slices_[highest][highest_index])
+              - Catalog.score(slices_[lowest][lowest_index])};
+          const float new_gap{std::abs(gap - 2.0f * difference)};
+          if (new_gap < best_gap) {
+            best_gap = new_gap;
+            best_highest_index = highest_index;
+            best_lowest_index = lowest_index;
+          }
+        }
+      }
+      if (best_gap >= gap) {
+        break;
+      }
+      SystemIndex& highest_system{slices_[highest][best_highest_index]};
+      SystemIndex& lowest_system{slices_[lowest][best_lowest_index]};
+      const float difference{
+          Catalog.score(highest_system) - Catalog.score(lowest_system)};
+      scores_[highest] -= difference;
+      scores_[lowest] += difference;
+      std::swap(highest_system, lowest_system);
+    }
+    for (const Player other : board_.players_) {
+      for (const SystemIndex system : slices_[static_cast<uint8_t>(other)]) {
+        system_slice_players_[system] = static_cast<uint8_t>(other);
+      }
+    }
+    for (typename Board::PlacementCandidate& candidate :
+         board_.placement_candidates_) {
+      if (!candidate.is_equidistant) {
+        candidate.slice_player = system_slice_players_[candidate.system];
+      }
+    }
+  }
+
+  /// \brief Randomly chooses two placement positions that are both
+  /// equidistant or both in the same slice. Larger groups are chosen more
+  /// often. Returns nothing if the chosen group has fewer than two positions.
+  std::optional<std::pair<uint8_t, uint8_t>> random_group_swap() noexcept {
+    const uint8_t group{
+        board_.placement_slice_players_[board_.random_engine_.below(
+            static_cast<uint32_t>(board_.placement_positions_.size()))]};
+    const std::vector<uint8_t>& indices{board_.placement_group_indices_[group]};
+    const uint32_t size{static_cast<uint32_t>(indices.size())};
+    if (size < 2) {
+      return std::nullopt;
+    }
+    const uint32_t first{board_.random_engine_.below(size)};
+    uint32_t second{board_.random_engine_.below(size - 1)};
+    if (second >= first) {
+      ++second;
+    }
+    return std::make_pair(indices[first], indices[second]);
+  }
+};  // class PartitionSearch
+
+}  // namespace TI4Cartographer
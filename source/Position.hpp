@@ -31,6 +31,17 @@ public:
     return azimuth_ <= maximum_azimuth(layer_);
   }
 
+  /// \brief Index of this position when all positions are numbered in order of
+  /// layer and then azimuth, starting from 0 at the center. Layers 0 through 4
+  /// contain 61 positions, so the ordinal of any position on a board fits in a
+  /// 64-bit mask.
+  uint8_t ordinal() const noexcept {
+    if (layer_ <= 0) {
+      return 0;
+    }
+    return static_cast<uint8_t>(3 * layer_ * (layer_ - 1) + 1 + azimuth_);
+  }
+
   /// \brief Returns true if this position is at one of the six "corners" of
   /// this layer.
   bool is_a_corner() const noexcept {
@@ -212,8 +223,9 @@ namespace std {
 template <>
 struct hash<TI4Cartographer::Position> {
   size_t operator()(const TI4Cartographer::Position& position) const {
-    return hash<int8_t>()(position.layer())
-           ^ hash<int8_t>()(position.azimuth());
+    // Position ordinals are unique, unlike a combination of the layer and the
+    // azimuth such as (1, 3) and (3, 1).
+    return position.ordinal();
   }
 };
 
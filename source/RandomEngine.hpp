@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Small and fast pseudo-random number generator: xoshiro256**. Its
+/// whole state is four 64-bit words, so copying it along with a board is
+/// cheap. Meets the requirements of a uniform random bit generator, but the
+/// board generation code uses its own bounded integer, real number, and
+/// shuffle functions, which avoid the overhead of the standard distributions.
+class RandomEngine {
+public:
+  using result_type = uint64_t;
+
+  RandomEngine() noexcept {
+    seed(0);
+  }
+
+  explicit RandomEngine(const uint64_t seed_value) noexcept {
+    seed(seed_value);
+  }
+
+  /// \brief Expands the seed into the state with SplitMix64, which never
+  /// produces the forbidden all-zero state.
+  void seed(uint64_t seed_value) noexcept {
+    for (uint64_t& word : state_) {
+      seed_value += 0x9E3779B97F4A7C15ULL;
+      uint64_t value{seed_value};
+      value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+      word = value ^ (value >> 31);
+    }
+  }
+
+  static constexpr result_type min() noexcept {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  static constexpr result_type max() noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() noexcept {
+    const uint64_t result{rotate_left(state_[1] * 5, 7) * 9};
+    const uint64_t shifted{state_[1] << 17};
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= shifted;
+    state_[3] = rotate_left(state_[3], 45);
+    return result;
+  }
+
+  /// \brief Returns a uniformly-distributed integer in [0, bound). The bound
+  /// must be at least 1. Uses Lemire's multiply-and-shift method, which only
+  /// needs a division in the rare case where a draw must be rejected to avoid
+  /// bias.
+  uint32_t below(const uint32_t bound) noexcept {
+    uint64_t product{upper_bits() * uint64_t{bound}};
+    uint32_t lower{static_cast<uint32_t>(product)};
+    if (lower < bound) {
+      const uint32_t threshold{static_cast<uint32_t>(0U - bound) % bound};
+      while (lower < threshold) {
+        product = upper_bits() * uint64_t{bound};
+        lower = static_cast<uint32_t>(product);
+      }
+    }
+    return static_cast<uint32_t>(product >> 32);
+  }
+
+  /// \brief Returns a uniformly-distributed real number in [0, 1).
+  float uniform() noexcept {
+    return static_cast<float>((*this)() >> 40) * (1.0f / 16777216.0f);
+  }
+
+  /// \brief Fisher–Yates shuffle of a compact array of indices, such as
+  /// placement indices or system indices.
+  template <typename Index>
+  void shuffle(std::vector<Index>& indices) noexcept {
+    static_assert(std::is_unsigned<Index>::value && sizeof(Index) <= 2,
+                  "Only shuffle compact arrays of indices.");
+    for (std::size_t size = indices.size(); size > 1; --size) {
+      std::swap(indices[size - 1],
+                indices[below(static_cast<uint32_t>(size))]);
+    }
+  }
+
+private:
+  std::array<uint64_t, 4> state_;
+
+  static constexpr uint64_t rotate_left(
+      const uint64_t value, const int shift) noexcept {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
+  uint64_t upper_bits() noexcept {
+    return (*this)() >> 32;
+  }
+
+};  // class RandomEngine
+
+}  // namespace TI4Cartographer
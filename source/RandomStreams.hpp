@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Counter-based source of independent random streams derived from one
+/// seed. Each stream is identified by a board number, an attempt number, and a
+/// worker number. Its seed is obtained by mixing these numbers into the seed
+/// with the SplitMix64 finalizer, so a stream does not depend on the order in
+/// which streams are created or on the thread that uses it. Runs with the same
+/// seed and a single thread are therefore reproducible.
+class RandomStreams {
+public:
+  RandomStreams() noexcept {}
+
+  explicit RandomStreams(const uint64_t seed) noexcept : seed_(seed) {}
+
+  uint64_t seed() const noexcept {
+    return seed_;
+  }
+
+  /// \brief Seed of the stream of the given worker during the given attempt
+  /// of the given board. Worker number 0 is the main thread.
+  uint64_t stream_seed(const uint32_t board_number,
+                       const uint8_t attempt_number,
+                       const uint16_t worker_number) const noexcept {
+    uint64_t state{seed_};
+    for (const uint64_t key :
+         {uint64_t{board_number}, uint64_t{attempt_number},
+          uint64_t{worker_number}}) {
+      state = mix(state ^ mix(key + golden_ratio_));
+    }
+    return state;
+  }
+
+  /// \brief Obtains a seed from the random device. Only call this from the main
+  /// thread.
+  static uint64_t random_seed() noexcept {
+    return (uint64_t{RandomDevice()} << 32) ^ uint64_t{RandomDevice()};
+  }
+
+private:
+  static constexpr const uint64_t golden_ratio_{0x9E3779B97F4A7C15ULL};
+
+  uint64_t seed_{0};
+
+  /// \brief SplitMix64 finalizer.
+  static uint64_t mix(uint64_t value) noexcept {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+  }
+
+};  // class RandomStreams
+
+}  // namespace TI4Cartographer
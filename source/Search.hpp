@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Search engine used to find a balanced board.
+enum class Search : uint8_t {
+  Random,
+  Annealing,
+  Exact,
+  Partition,
+  Tempering,
+  Genetic,
+};
+
+template <>
+const std::unordered_map<Search, std::string> labels<Search>{
+    {Search::Random,    "Random"   },
+    {Search::Annealing, "Annealing"},
+    {Search::Exact,     "Exact"    },
+    {Search::Partition, "Partition"},
+    {Search::Tempering, "Tempering"},
+    {Search::Genetic,   "Genetic"  },
+};
+
+template <>
+const std::unordered_map<std::string, Search> spellings<Search>{
+    {"random",             Search::Random   },
+    {"annealing",          Search::Annealing},
+    {"simulatedannealing", Search::Annealing},
+    {"exact",              Search::Exact    },
+    {"branchandbound",     Search::Exact    },
+    {"partition",          Search::Partition},
+    {"twophase",           Search::Partition},
+    {"tempering",          Search::Tempering},
+    {"paralleltempering",  Search::Tempering},
+    {"replicaexchange",    Search::Tempering},
+    {"genetic",            Search::Genetic  },
+    {"geneticalgorithm",   Search::Genetic  },
+};
+
+}  // namespace TI4Cartographer
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Checks that can reject a board during a search.
+enum class ValidityCheck : uint8_t {
+  ConstrainedPlacement,
+  AdjacentAnomaliesOrWormholes,
+  PathwaysToMecatolRex,
+  WormholesAdjacentToHomes,
+  EnoughPlanets,
+  EnoughUsefulResourcesAndUsefulInfluence,
+};
+
+constexpr const uint8_t NumberOfValidityChecks{6};
+
+template <>
+const std::unordered_map<ValidityCheck, std::string> labels<ValidityCheck>{
+    {ValidityCheck::ConstrainedPlacement, "place_constrained_candidates"},
+    {ValidityCheck::AdjacentAnomaliesOrWormholes,
+     "contains_adjacent_anomalies_or_wormholes"},
+    {ValidityCheck::PathwaysToMecatolRex, "pathways_to_mecatol_rex_are_clear"},
+    {ValidityCheck::WormholesAdjacentToHomes,
+     "players_do_not_have_too_many_wormholes_adjacent_to_their_homes"},
+    {ValidityCheck::EnoughPlanets, "players_have_enough_planets"},
+    {ValidityCheck::EnoughUsefulResourcesAndUsefulInfluence,
+     "players_have_enough_useful_resources_and_useful_influence"},
+};
+
+/// \brief Terms of the player scores, plus the incremental update of the
+/// player scores after a swap and the scoring of a batch of boards.
+enum class ScoringTerm : uint8_t {
+  BaseSystems,
+  PreferredExpansionPositions,
+  AlternateExpansionPositions,
+  MecatolRexPathways,
+  SystemsContainingPlanetsAdjacentToHome,
+  IncrementalSwap,
+  Batch,
+};
+
+constexpr const uint8_t NumberOfScoringTerms{7};
+
+template <>
+const std::unordered_map<ScoringTerm, std::string> labels<ScoringTerm>{
+    {ScoringTerm::BaseSystems, "add_base_system_scores"},
+    {ScoringTerm::PreferredExpansionPositions,
+     "add_preferred_expansion_position_scores"},
+    {ScoringTerm::AlternateExpansionPositions,
+     "add_alternate_expansion_position_scores"},
+    {ScoringTerm::MecatolRexPathways, "add_mecatol_rex_pathway_scores"},
+    {ScoringTerm::SystemsContainingPlanetsAdjacentToHome,
+     "add_number_of_systems_containing_planets_adjacent_to_home_scores"},
+    {ScoringTerm::IncrementalSwap, "swap_system_ids_and_update_player_scores"},
+    {ScoringTerm::Batch, "calculate_batch_score_imbalance_ratios"},
+};
+
+/// \brief Instrumentation counters of a search: the number of evaluations,
+/// the number of rejections, and the cumulative time of each validity check,
+/// and the number of evaluations and the cumulative time of each scoring term.
+/// Only updated when statistics are requested.
+class SearchCounters {
+public:
+  SearchCounters() noexcept {}
+
+  /// \brief Returns the time elapsed since the given time point, in
+  /// nanoseconds.
+  static uint64_t nanoseconds_since(
+      const std::chrono::steady_clock::time_point start) noexcept {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+  }
+
+  void record(const ValidityCheck check, const bool passed,
+              const uint64_t nanoseconds) noexcept {
+    const uint8_t index{static_cast<uint8_t>(check)};
+    ++check_evaluations_[index];
+    if (!passed) {
+      ++check_rejections_[index];
+    }
+    check_nanoseconds_[index] += nanoseconds;
+  }
+
+  void record(const ScoringTerm term, const uint64_t nanoseconds) noexcept {
+    const uint8_t index{static_cast<uint8_t>(term)};
+    ++term_evaluations_[index];
+    term_nanoseconds_[index] += nanoseconds;
+  }
+
+  void add_iterations(const uint64_t number_of_iterations,
+                      const uint64_t number_of_valid_boards) noexcept {
+    number_of_iterations_ += number_of_iterations;
+    number_of_valid_boards_ += number_of_valid_boards;
+  }
+
+  /// \brief Records a probe of the transposition table and whether it found
+  /// the board.
+  void record_transposition_probe(const bool hit) noexcept {
+    ++transposition_probes_;
+    if (hit) {
+      ++transposition_hits_;
+    }
+  }
+
+  SearchCounters& operator+=(const SearchCounters& other) noexcept {
+    number_of_iterations_ += other.number_of_iterations_;
+    number_of_valid_boards_ += other.number_of_valid_boards_;
+    transposition_probes_ += other.transposition_probes_;
+    transposition_hits_ += other.transposition_hits_;
+    for (uint8_t index = 0; index < NumberOfValidityChecks; ++index) {
+      check_evaluations_[index] += other.check_evaluations_[index];
+      check_rejections_[index] += other.check_rejections_[index];
+      check_nanoseconds_[index] += other.check_nanoseconds_[index];
+    }
+    for (uint8_t index = 0; index < NumberOfScoringTerms; ++index) {
+      term_evaluations_[index] += other.term_evaluations_[index];
+      term_nanoseconds_[index] += other.term_nanoseconds_[index];
+    }
+    return *this;
+  }
+
+  /// \brief Prints the counters as a JSON object.
+  std::string print_json() const noexcept {
+    std::string text{
+        "{\"iterations\":" + std::to_string(number_of_iterations_)
+        + ",\"valid_boards\":" + std::to_string(number_of_valid_boards_)
+        + ",\"transposition_table\":{\"probes\":"
+        + std::to_string(transposition_probes_)
+        + ",\"hits\":" + std::to_string(transposition_hits_)
+        + ",\"hit_rate\":" + print_hit_rate() + "},\"checks\":{"};
+    for (uint8_t index = 0; index < NumberOfValidityChecks; ++index) {
+      if (index > 0) {
+        text += ",";
+      }
+      text += "\"" + label(static_cast<ValidityCheck>(index))
+              + "\":{\"evaluations\":"
+              + std::to_string(check_evaluations_[index])
+              + ",\"rejections\":" + std::to_string(check_rejections_[index])
+              + ",\"nanoseconds\":" + std::to_string(check_nanoseconds_[index])
+              + "}";
+    }
+    text += "},\"terms\":{";
+    for (uint8_t index = 0; index < NumberOfScoringTerms; ++index) {
+      if (index > 0) {
+        text += ",";
+      }
+      text += "\"" + label(static_cast<ScoringTerm>(index))
+              + "\":{\"evaluations\":"
+              + std::to_string(term_evaluations_[index])
+              + ",\"nanoseconds\":" + std::to_string(term_nanoseconds_[index])
+              + "}";
+    }
+    text += "}}";
+    return text;
+  }
+
+private:
+  uint64_t number_of_iterations_{0};
+
+  uint64_t number_of_valid_boards_{0};
+
+  uint64_t transposition_probes_{0};
+
+  uint64_t transposition_hits_{0};
+
+  /// \brief Fraction of the probes of the transposition table that found the
+  /// board, with four decimals.
+  std::string print_hit_rate() const noexcept {
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(4)
+           << (transposition_probes_ == 0 ?
+                   0.0 :
+                   static_cast<double>(transposition_hits_)
+                       / static_cast<double>(transposition_probes_));
+    return stream.str();
+  }
+
+  std::array<uint64_t, NumberOfValidityChecks> check_evaluations_{};
+
+  std::array<uint64_t, NumberOfValidityChecks> check_rejections_{};
+
+  std::array<uint64_t, NumberOfValidityChecks> check_nanoseconds_{};
+
+  std::array<uint64_t, NumberOfScoringTerms> term_evaluations_{};
+
+  std::array<uint64_t, NumberOfScoringTerms> term_nanoseconds_{};
+
+};  // class SearchCounters
+
+}  // namespace TI4Cartographer
@@ -1,27 +1,30 @@
 #pragma once
 
-#include "Base.hpp"
+#include "RandomEngine.hpp"
+#include "SystemCatalog.hpp"
 
 namespace TI4Cartographer {
 
+/// \brief Selected systems that are placed on in-slice positions. Stored as
+/// system indices so that shuffling only moves small integers.
 class SelectedInSliceSystemIds {
 public:
   SelectedInSliceSystemIds() noexcept {}
 
-  SelectedInSliceSystemIds(const std::vector<std::string>& data) noexcept
+  SelectedInSliceSystemIds(const std::vector<SystemIndex>& data) noexcept
     : data_(data) {}
 
-  void push_back(const std::string& system_id) noexcept {
-    data_.push_back(system_id);
+  void push_back(const SystemIndex system) noexcept {
+    data_.push_back(system);
   }
 
-  void shuffle() noexcept {
-    std::shuffle(data_.begin(), data_.end(), RandomEngine);
+  void shuffle(RandomEngine& random_engine) noexcept {
+    random_engine.shuffle(data_);
   }
 
-  struct const_iterator : public std::vector<std::string>::const_iterator {
-    const_iterator(const std::vector<std::string>::const_iterator i) noexcept
-      : std::vector<std::string>::const_iterator(i) {}
+  struct const_iterator : public std::vector<SystemIndex>::const_iterator {
+    const_iterator(const std::vector<SystemIndex>::const_iterator i) noexcept
+      : std::vector<SystemIndex>::const_iterator(i) {}
   };
 
   bool empty() const noexcept {
@@ -32,7 +35,7 @@ public:
     return data_.size();
   }
 
-  const std::string& at(const std::size_t index) const {
+  SystemIndex at(const std::size_t index) const {
     return data_.at(index);
   }
 
@@ -52,25 +55,25 @@ public:
     return cend();
   }
 
-  const std::string& front() const noexcept {
+  SystemIndex front() const noexcept {
     return data_.front();
   }
 
-  const std::string& back() const noexcept {
+  SystemIndex back() const noexcept {
     return data_.back();
   }
 
-  const std::string& operator[](const std::size_t index) const {
+  SystemIndex operator[](const std::size_t index) const {
     return data_[index];
   }
 
   std::string print_brief() const noexcept {
     std::string text;
-    for (const std::string& system_id : data_) {
+    for (const SystemIndex system : data_) {
       if (!text.empty()) {
         text += " ";
       }
-      text += system_id;
+      text += Catalog.id(system);
     }
     return text;
   }
@@ -78,23 +81,19 @@ public:
   std::string print_details() const noexcept {
     std::stringstream stream;
     uint8_t counter{0};
-    for (const std::string& system_id : data_) {
-      const std::unordered_set<System>::const_iterator found{
-          Systems.find({system_id})};
-      if (found != Systems.cend()) {
-        if (counter > 0) {
-          stream << std::endl;
-        }
-        stream << "- " << score_to_string(found->score()) << "  "
-               << found->print();
-        ++counter;
+    for (const SystemIndex system : data_) {
+      if (counter > 0) {
+        stream << std::endl;
       }
+      stream << "- " << score_to_string(Catalog.score(system)) << "  "
+             << Catalog.system(system).print();
+      ++counter;
     }
     return stream.str();
   }
 
 private:
-  std::vector<std::string> data_;
+  std::vector<SystemIndex> data_;
 
 };  // class SelectedInSliceSystemIds
 
@@ -2,9 +2,9 @@
 
 #include "Aggression.hpp"
 #include "Layout.hpp"
+#include "RandomEngine.hpp"
 #include "SelectedEquidistantSystemIds.hpp"
 #include "SelectedInSliceSystemIds.hpp"
-#include "Systems.hpp"
 
 namespace TI4Cartographer {
 
@@ -15,17 +15,42 @@ public:
 
   SelectedSystemIds(const GameVersion game_version, const Layout layout,
                     const Aggression aggression,
-                    const uint8_t number_of_equidistant_systems) {
-    initialize(game_version, layout, aggression, number_of_equidistant_systems);
+                    const uint8_t number_of_equidistant_systems,
+                    RandomEngine& random_engine) {
+    initialize(game_version, layout, aggression, number_of_equidistant_systems,
+               random_engine);
     verbose_message("Equidistant systems:");
     verbose_message(equidistant_.print_details());
     verbose_message("In-slice systems:");
     verbose_message(in_slice_.print_details());
   }
 
-  void shuffle() noexcept {
-    equidistant_.shuffle();
-    in_slice_.shuffle();
+  void shuffle(RandomEngine& random_engine) noexcept {
+    equidistant_.shuffle(random_engine);
+    in_slice_.shuffle(random_engine);
+  }
+
+  /// \brief Returns true if enough systems of each category exist in the given
+  /// game version to fill the given board layout.
+  static bool enough_systems_exist(
+      const GameVersion game_version, const Layout layout) noexcept {
+    for (const SystemCategory system_category :
+         {SystemCategory::Planetary, SystemCategory::AnomalyWormholeEmpty}) {
+      std::size_t number_of_relevant_systems{0};
+      for (std::size_t index = 0; index < Catalog.size(); ++index) {
+        const SystemIndex system{static_cast<SystemIndex>(index)};
+        if (Catalog.category(system) == system_category
+            && is_relevant(
+                Catalog.system(system).game_version(), game_version)) {
+          ++number_of_relevant_systems;
+        }
+      }
+      if (number_of_relevant_systems
+          < number_of_systems(system_category, layout)) {
+        return false;
+      }
+    }
+    return true;
   }
 
   const SelectedEquidistantSystemIds& equidistant() const noexcept {
@@ -43,118 +68,107 @@ protected:
 
   void initialize(const GameVersion game_version, const Layout layout,
                   const Aggression aggression,
-                  const uint8_t number_of_equidistant_systems) {
-    const std::vector<SystemIdAndScore> selected_sorted_system_ids_and_scores_{
-        selected_sorted_system_ids_and_scores(game_version, layout)};
+                  const uint8_t number_of_equidistant_systems,
+                  RandomEngine& random_engine) {
+    const std::vector<SystemIndex> selected_sorted_systems_{
+        selected_sorted_systems(game_version, layout, random_engine)};
     const uint8_t number_of_systems{
-        static_cast<uint8_t>(selected_sorted_system_ids_and_scores_.size())};
+        static_cast<uint8_t>(selected_sorted_systems_.size())};
     // Randomly choose the equidistant systems from among the possible ones.
     const std::vector<uint8_t> shuffled_possible_equidistant_indices_{
         shuffled_possible_equidistant_indices(
-            aggression, number_of_systems, number_of_equidistant_systems)};
+            aggression, number_of_systems, number_of_equidistant_systems,
+            random_engine)};
     std::unordered_set<uint8_t> equidistant_indices;
     for (uint8_t counter = 0; counter < number_of_equidistant_systems;
          ++counter) {
       const uint8_t index{shuffled_possible_equidistant_indices_[counter]};
       equidistant_indices.insert(index);
-      equidistant_.push_back(
-          selected_sorted_system_ids_and_scores_[index].id());
+      equidistant_.push_back(selected_sorted_systems_[index]);
     }
     // The remaining indices are the in-slice ones.
     for (uint8_t index = 0; index < number_of_systems; ++index) {
       if (equidistant_indices.find(index) == equidistant_indices.cend()) {
-        in_slice_.push_back(selected_sorted_system_ids_and_scores_[index].id());
+        in_slice_.push_back(selected_sorted_systems_[index]);
       }
     }
   }
 
-  std::vector<SystemIdAndScore> selected_sorted_system_ids_and_scores(
-      const GameVersion game_version, const Layout layout) const noexcept {
-    std::vector<SystemIdAndScore> selected_sorted_system_ids_and_scores_;
-    for (const std::string& system_id : shuffled_selected_system_ids(
-             SystemCategory::Planetary, game_version, layout)) {
-      selected_sorted_system_ids_and_scores_.push_back(
-          {system_id, Systems.find({system_id})->score()});
+  /// \brief Returns the selected systems sorted by descending score. Systems
+  /// with equal scores are sorted by system ID, which is the order of the
+  /// system indices.
+  std::vector<SystemIndex> selected_sorted_systems(
+      const GameVersion game_version, const Layout layout,
+      RandomEngine& random_engine) const noexcept {
+    std::vector<SystemIndex> selected_sorted_systems_{shuffled_selected_systems(
+        SystemCategory::Planetary, game_version, layout, random_engine)};
+    for (const SystemIndex system : shuffled_selected_systems(
+             SystemCategory::AnomalyWormholeEmpty, game_version, layout,
+             random_engine)) {
+      selected_sorted_systems_.push_back(system);
     }
-    for (const std::string& system_id : shuffled_selected_system_ids(
-             SystemCategory::AnomalyWormholeEmpty, game_version, layout)) {
-      selected_sorted_system_ids_and_scores_.push_back(
-          {system_id, Systems.find({system_id})->score()});
-    }
-    std::sort(selected_sorted_system_ids_and_scores_.begin(),
-              selected_sorted_system_ids_and_scores_.end(),
-              SystemIdAndScore::sort_by_descending_score());
-    return selected_sorted_system_ids_and_scores_;
+    std::sort(selected_sorted_systems_.begin(), selected_sorted_systems_.end(),
+              [](const SystemIndex system_1, const SystemIndex system_2)
+                  -> bool {
+                if (Catalog.score(system_1) != Catalog.score(system_2)) {
+                  return Catalog.score(system_1) > Catalog.score(system_2);
+                }
+                return system_1 < system_2;
+              });
+    return selected_sorted_systems_;
   }
 
-  std::vector<std::string> shuffled_selected_system_ids(
+  std::vector<SystemIndex> shuffled_selected_systems(
       const SystemCategory system_category, const GameVersion game_version,
-      const Layout layout) const {
-    std::vector<std::string> all_relevant_system_ids_;
-    switch (game_version) {
-      case GameVersion::BaseGame:
-        for (const System& system : Systems) {
-          if (system.category() == system_category
-              && system.game_version() == GameVersion::BaseGame) {
-            all_relevant_system_ids_.push_back(system.id());
-          }
-        }
-        break;
-      case GameVersion::ProphecyOfKingsExpansion:
-        for (const System& system : Systems) {
-          if (system.category() == system_category
-              && (system.game_version() == GameVersion::BaseGame
-                  || system.game_version()
-                         == GameVersion::ProphecyOfKingsExpansion)) {
-            all_relevant_system_ids_.push_back(system.id());
-          }
-        }
-        break;
-      case GameVersion::ThundersEdgeExpansion:
-        for (const System& system : Systems) {
-          if (system.category() == system_category
-              && (system.game_version() == GameVersion::BaseGame
-                  || system.game_version()
-                         == GameVersion::ThundersEdgeExpansion)) {
-            all_relevant_system_ids_.push_back(system.id());
-          }
-        }
-        break;
-      case GameVersion::ProphecyOfKingsAndThundersEdgeExpansions:
-        for (const System& system : Systems) {
-          if (system.category() == system_category
-              && (system.game_version() == GameVersion::BaseGame
-                  || system.game_version()
-                         == GameVersion::ProphecyOfKingsExpansion
-                  || system.game_version()
-                         == GameVersion::ThundersEdgeExpansion)) {
-            all_relevant_system_ids_.push_back(system.id());
-          }
-        }
-        break;
+      const Layout layout, RandomEngine& random_engine) const {
+    std::vector<SystemIndex> all_relevant_systems_;
+    for (std::size_t index = 0; index < Catalog.size(); ++index) {
+      const SystemIndex system{static_cast<SystemIndex>(index)};
+      if (Catalog.category(system) == system_category
+          && is_relevant(Catalog.system(system).game_version(), game_version)) {
+        all_relevant_systems_.push_back(system);
+      }
     }
-    std::shuffle(all_relevant_system_ids_.begin(),
-                 all_relevant_system_ids_.end(), RandomEngine);
+    random_engine.shuffle(all_relevant_systems_);
     const uint8_t number_of_systems_needed{
         number_of_systems(system_category, layout)};
-    if (all_relevant_system_ids_.size() < number_of_systems_needed) {
+    if (all_relevant_systems_.size() < number_of_systems_needed) {
       error("This game board needs " + std::to_string(number_of_systems_needed)
             + " " + label(system_category) + " systems, but there are only "
-            + std::to_string(all_relevant_system_ids_.size()) + " "
+            + std::to_string(all_relevant_systems_.size()) + " "
             + label(system_category) + " systems that exist in total.");
       return {};
     } else {
-      std::vector<std::string> selected_relevant_system_ids;
-      for (std::size_t index = 0; index < number_of_systems_needed; ++index) {
-        selected_relevant_system_ids.push_back(all_relevant_system_ids_[index]);
-      }
-      return selected_relevant_system_ids;
+      all_relevant_systems_.resize(number_of_systems_needed);
+      return all_relevant_systems_;
     }
   }
 
+  /// \brief Returns true if a system from the given game version can be used
+  /// when playing the given game version.
+  static bool is_relevant(const GameVersion system_game_version,
+                          const GameVersion game_version) noexcept {
+    switch (game_version) {
+      case GameVersion::BaseGame:
+        return system_game_version == GameVersion::BaseGame;
+      case GameVersion::ProphecyOfKingsExpansion:
+        return system_game_version == GameVersion::BaseGame
+               || system_game_version == GameVersion::ProphecyOfKingsExpansion;
+      case GameVersion::ThundersEdgeExpansion:
+        return system_game_version == GameVersion::BaseGame
+               || system_game_version == GameVersion::ThundersEdgeExpansion;
+      case GameVersion::ProphecyOfKingsAndThundersEdgeExpansions:
+        return system_game_version == GameVersion::BaseGame
+               || system_game_version == GameVersion::ProphecyOfKingsExpansion
+               || system_game_version == GameVersion::ThundersEdgeExpansion;
+    }
+    return false;
+  }
+
   std::vector<uint8_t> shuffled_possible_equidistant_indices(
       const Aggression aggression, const uint8_t number_of_systems,
-      const uint8_t number_of_equidistant_systems) const noexcept {
+      const uint8_t number_of_equidistant_systems,
+      RandomEngine& random_engine) const noexcept {
     std::pair<uint8_t, uint8_t> start_and_end_indices;
     switch (aggression) {
       case Aggression::Low:
@@ -175,8 +189,7 @@ protected:
          index < start_and_end_indices.second; ++index) {
       possible_equidistant_indices_.push_back(index);
     }
-    std::shuffle(possible_equidistant_indices_.begin(),
-                 possible_equidistant_indices_.end(), RandomEngine);
+    random_engine.shuffle(possible_equidistant_indices_);
     return possible_equidistant_indices_;
   }
 
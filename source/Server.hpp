@@ -0,0 +1,351 @@
+#pragma once
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Board.hpp"
+#include "Instructions.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Long-running server that generates boards on request over a Unix
+/// domain socket. The system catalog and an initialized board of every layout
+/// are kept in memory, so each request only pays for the board generation
+/// itself. Each request is one line of arguments with the same syntax as the
+/// command line, for example "--players 6 --layout regular --seed 42
+/// --time-limit-ms 500". Supported arguments are --players, --layout,
+/// --aggression, --version, --search, --seed, and --time-limit-ms; omitted
+/// arguments take the values given when starting the server. Every request
+/// has a time limit: without one, a default time limit applies, and longer
+/// time limits are reduced to a maximum, so that no request can occupy a
+/// worker indefinitely. Each response is
+/// one line that contains either the Tabletop Simulator string of the board or
+/// "error: " followed by a description of the problem. A request longer than
+/// a few kilobytes is answered with an error and discarded. A pool of worker
+/// threads serves the clients concurrently, one client per worker at a time.
+class Server {
+public:
+  Server(const std::string& socket_path, const Settings& default_settings)
+    : socket_path_(socket_path), default_settings_(default_settings) {
+    for (uint8_t layout_value = 0;
+         layout_value <= static_cast<uint8_t>(Layout::Players8Large);
+         ++layout_value) {
+      const Layout layout{static_cast<Layout>(layout_value)};
+      boards_.emplace(layout, Board{layout});
+    }
+  }
+
+  /// \brief Serves clients until a stop signal is received.
+  void run() {
+    open_socket();
+    // A client that disconnects early must not terminate the server.
+    std::signal(SIGPIPE, SIG_IGN);
+    std::vector<std::thread> workers;
+    for (uint16_t counter = 0; counter < default_settings_.number_of_threads();
+         ++counter) {
+      workers.emplace_back([this]() { serve_clients(); });
+    }
+    message("Listening on " + socket_path_ + " with "
+            + std::to_string(workers.size()) + " worker threads.");
+    flush_messages();
+    while (!StopRequested.load(std::memory_order_relaxed)) {
+      if (!wait_until_readable(listener_)) {
+        continue;
+      }
+      const int client{accept(listener_, nullptr, nullptr)};
+      if (client >= 0) {
+        const std::lock_guard<std::mutex> lock{clients_mutex_};
+        clients_.push_back(client);
+        clients_condition_.notify_one();
+      }
+    }
+    clients_condition_.notify_all();
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    close_socket();
+    message("Stopped listening on " + socket_path_ + ".");
+    flush_messages();
+  }
+
+private:
+  /// \brief Blocking calls wake up this often to check for a stop signal.
+  static constexpr const int poll_timeout_milliseconds_{200};
+
+  /// \brief Longest accepted request, in characters, excluding the newline.
+  /// This bounds the memory that a client can make a worker buffer.
+  static constexpr const std::size_t maximum_request_length_{4096};
+
+  /// \brief Time limit of a request when neither the request nor the command
+  /// line that started the server gives one.
+  static constexpr const uint64_t default_time_limit_milliseconds_{10000};
+
+  /// \brief Longer time limits are reduced to this.
+  static constexpr const uint64_t maximum_time_limit_milliseconds_{60000};
+
+  std::string socket_path_;
+
+  /// \brief Settings given when starting the server. Each request starts from
+  /// these.
+  Settings default_settings_;
+
+  /// \brief Initialized board of each layout. Never modified after
+  /// construction, so the workers can copy them concurrently.
+  std::map<Layout, Board> boards_;
+
+  int listener_{-1};
+
+  std::deque<int> clients_;
+
+  std::mutex clients_mutex_;
+
+  std::condition_variable clients_condition_;
+
+  /// \brief The random device is not thread-safe.
+  std::mutex random_seed_mutex_;
+
+  void open_socket() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path_.empty()
+        || socket_path_.size() >= sizeof(address.sun_path)) {
+      error("Invalid socket path: " + socket_path_);
+    }
+    std::copy(socket_path_.cbegin(), socket_path_.cend(), address.sun_path);
+    listener_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener_ < 0) {
+      error("Cannot create a socket.");
+    }
+    // Remove a stale socket left behind by a previous server.
+    unlink(socket_path_.c_str());
+    if (bind(listener_, reinterpret_cast<const sockaddr*>(&address),
+             sizeof(address))
+            != 0
+        || listen(listener_, SOMAXCONN) != 0) {
+      close(listener_);
+      error("Cannot listen on the socket: " + socket_path_);
+    }
+  }
+
+  void close_socket() noexcept {
+    close(listener_);
+    unlink(socket_path_.c_str());
+  }
+
+  /// \brief Returns true if the file descriptor is readable. Returns false
+  /// after a timeout so that the caller can check for a stop signal.
+  static bool wait_until_readable(const int file_descriptor) noexcept {
+    pollfd poll_file_descriptor{file_descriptor, POLLIN, 0};
+    return poll(&poll_file_descriptor, 1, poll_timeout_milliseconds_) > 0;
+  }
+
+  void serve_clients() {
+    while (true) {
+      int client{-1};
+      {
+        std::unique_lock<std::mutex> lock{clients_mutex_};
+        clients_condition_.wait(lock, [this]() {
+          return !clients_.empty()
+                 || StopRequested.load(std::memory_order_relaxed);
+        });
+        if (clients_.empty()) {
+          return;
+        }
+        client = clients_.front();
+        clients_.pop_front();
+      }
+      serve_client(client);
+    }
+  }
+
+  /// \brief Answers each newline-delimited request of a client until it
+  /// disconnects. A request that exceeds the maximum length is answered with an
+  /// error as soon as the limit is reached, and the rest of its line is
+  /// discarded as it arrives.
+  void serve_client(const int client) {
+    std::string buffer;
+    std::array<char, 4096> chunk;
+    bool connected{true};
+    bool discarding{false};
+    while (connected && !StopRequested.load(std::memory_order_relaxed)) {
+      if (!wait_until_readable(client)) {
+        continue;
+      }
+      const ssize_t size{read(client, chunk.data(), chunk.size())};
+      if (size <= 0) {
+        break;
+      }
+      buffer.append(chunk.data(), static_cast<std::size_t>(size));
+      std::size_t newline{buffer.find('\n')};
+      while (connected && newline != std::string::npos) {
+        std::string request{buffer.substr(0, newline)};
+        buffer.erase(0, newline + 1);
+        if (discarding) {
+          discarding = false;
+        } else if (request.size() > maximum_request_length_) {
+          connected = write_line(client, request_too_long_error());
+        } else {
+          if (!request.empty() && request.back() == '\r') {
+            request.pop_back();
+          }
+          if (!request.empty()) {
+            connected = write_line(client, respond(request));
+          }
+        }
+        newline = buffer.find('\n');
+      }
+      if (connected && buffer.size() > maximum_request_length_) {
+        if (!discarding) {
+          connected = write_line(client, request_too_long_error());
+          discarding = true;
+        }
+        buffer.clear();
+      }
+    }
+    close(client);
+  }
+
+  static std::string request_too_long_error() noexcept {
+    return "error: The request is longer than "
+           + std::to_string(maximum_request_length_) + " characters.";
+  }
+
+  static bool write_line(const int client, const std::string& text) noexcept {
+    const std::string line{text + "\n"};
+    std::size_t written{0};
+    while (written < line.size()) {
+      const ssize_t size{
+          write(client, line.data() + written, line.size() - written)};
+      if (size <= 0) {
+        return false;
+      }
+      written += static_cast<std::size_t>(size);
+    }
+    return true;
+  }
+
+  std::string respond(const std::string& request) {
+    try {
+      const Settings settings{parse_request(request)};
+      Board board{boards_.at(settings.layout())};
+      return board.generate(settings);
+    } catch (const std::exception& exception) {
+      return "error: " + std::string{exception.what()};
+    }
+  }
+
+  Settings parse_request(const std::string& request) {
+    Settings settings{default_settings_};
+    settings.set_number_of_threads(1);
+    settings.set_number_of_boards(1);
+    settings.set_stats(false);
+    std::vector<std::string> words;
+    std::istringstream stream{request};
+    std::string word;
+    while (stream >> word) {
+      words.push_back(word);
+    }
+    if (words.size() % 2 != 0) {
+      throw std::runtime_error("Each argument needs a value: " + request);
+    }
+    uint8_t players{number_of_players(settings.layout())};
+    // A request that only gives the number of players keeps the layout type
+    // given when starting the server.
+    std::string layout_string{layout_type(settings.layout())};
+    bool layout_is_requested{false};
+    bool seed_is_initialized{false};
+    for (std::size_t index = 0; index < words.size(); index += 2) {
+      const std::string& key{words[index]};
+      const std::string& value{words[index + 1]};
+      if (key == Arguments::NumberOfPlayersKey) {
+        const uint64_t number{parse_number(key, value)};
+        if (number < 2 || number > 8) {
+          throw std::runtime_error("The number of players must be 2-8.");
+        }
+        players = static_cast<uint8_t>(number);
+        layout_is_requested = true;
+      } else if (key == Arguments::LayoutKey) {
+        layout_string = value;
+        layout_is_requested = true;
+      } else if (key == Arguments::AggressionKey) {
+        settings.set_aggression(parse_type<Aggression>(key, value));
+      } else if (key == Arguments::GameVersionKey) {
+        settings.set_game_version(parse_type<GameVersion>(key, value));
+      } else if (key == Arguments::SearchKey) {
+        settings.set_search(parse_type<Search>(key, value));
+      } else if (key == Arguments::SeedKey) {
+        settings.set_seed(parse_number(key, value));
+        seed_is_initialized = true;
+      } else if (key == Arguments::TimeLimitKey) {
+        settings.set_time_limit_milliseconds(parse_number(key, value));
+      } else {
+        throw std::runtime_error("Unknown argument: " + key);
+      }
+    }
+    if (layout_is_requested) {
+      const std::optional<Layout> layout{type<Layout>(
+          std::to_string(players) + "players"
+          + lowercase(remove_non_alphanumeric_characters(layout_string)))};
+      if (!layout.has_value()) {
+        throw std::runtime_error("Unknown board layout for "
+                                 + std::to_string(players)
+                                 + " players: " + layout_string);
+      }
+      settings.set_layout(layout.value());
+    }
+    if (!layout_and_game_version_are_compatible(
+            settings.layout(), settings.game_version())
+        || !SelectedSystemIds::enough_systems_exist(
+            settings.game_version(), settings.layout())) {
+      throw std::runtime_error(
+          "The " + label(settings.layout()) + " board layout cannot be used "
+          + "with the " + label(settings.game_version()) + ".");
+    }
+    if (settings.time_limit_milliseconds() == 0) {
+      settings.set_time_limit_milliseconds(default_time_limit_milliseconds_);
+    }
+    settings.set_time_limit_milliseconds(std::min(
+        settings.time_limit_milliseconds(), maximum_time_limit_milliseconds_));
+    if (!seed_is_initialized) {
+      const std::lock_guard<std::mutex> lock{random_seed_mutex_};
+      settings.set_seed(RandomStreams::random_seed());
+    }
+    return settings;
+  }
+
+  /// \brief Type of a board layout, such as "regular", "small", or "large".
+  static std::string layout_type(const Layout layout) {
+    const std::string& text{label(layout)};
+    return lowercase(text.substr(text.rfind(' ') + 1));
+  }
+
+  static uint64_t parse_number(
+      const std::string& key, const std::string& value) {
+    if (value.empty()
+        || !std::all_of(value.cbegin(), value.cend(), [](const char digit) {
+             return std::isdigit(static_cast<unsigned char>(digit)) != 0;
+           })) {
+      throw std::runtime_error("Invalid value for " + key + ": " + value);
+    }
+    try {
+      return static_cast<uint64_t>(std::stoull(value));
+    } catch (const std::out_of_range&) {
+      throw std::runtime_error("Invalid value for " + key + ": " + value);
+    }
+  }
+
+  template <typename Enumeration>
+  static Enumeration parse_type(
+      const std::string& key, const std::string& value) {
+    const std::optional<Enumeration> found{type<Enumeration>(value)};
+    if (!found.has_value()) {
+      throw std::runtime_error("Invalid value for " + key + ": " + value);
+    }
+    return found.value();
+  }
+
+};  // class Server
+
+}  // namespace TI4Cartographer
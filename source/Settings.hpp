@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Aggression.hpp"
+#include "GameVersion.hpp"
+#include "Layout.hpp"
+#include "Search.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Settings that control the generation of a board.
+class Settings {
+public:
+  Settings() noexcept {}
+
+  Settings(const GameVersion game_version, const Layout layout,
+           const Aggression aggression,
+           const uint16_t number_of_threads = 1) noexcept
+    : game_version_(game_version), layout_(layout), aggression_(aggression),
+      number_of_threads_(number_of_threads) {}
+
+  GameVersion game_version() const noexcept {
+    return game_version_;
+  }
+
+  Layout layout() const noexcept {
+    return layout_;
+  }
+
+  Aggression aggression() const noexcept {
+    return aggression_;
+  }
+
+  Search search() const noexcept {
+    return search_;
+  }
+
+  /// \brief Number of worker threads that generate boards in parallel. Always
+  /// at least 1.
+  uint16_t number_of_threads() const noexcept {
+    return number_of_threads_;
+  }
+
+  void set_game_version(const GameVersion game_version) noexcept {
+    game_version_ = game_version;
+  }
+
+  void set_layout(const Layout layout) noexcept {
+    layout_ = layout;
+  }
+
+  void set_aggression(const Aggression aggression) noexcept {
+    aggression_ = aggression;
+  }
+
+  void set_search(const Search search) noexcept {
+    search_ = search;
+  }
+
+  /// \brief Time limit of the generation of each board, in milliseconds. Once
+  /// it is reached, the best board found so far is used. A value of 0 means
+  /// that there is no time limit.
+  uint64_t time_limit_milliseconds() const noexcept {
+    return time_limit_milliseconds_;
+  }
+
+  void set_time_limit_milliseconds(
+      const uint64_t time_limit_milliseconds) noexcept {
+    time_limit_milliseconds_ = time_limit_milliseconds;
+  }
+
+  /// \brief If true, the search engines record counters of the validity checks
+  /// and scoring terms, which are printed as JSON at exit.
+  bool stats() const noexcept {
+    return stats_;
+  }
+
+  void set_stats(const bool stats) noexcept {
+    stats_ = stats;
+  }
+
+  /// \brief Seed from which all random streams are derived.
+  uint64_t seed() const noexcept {
+    return seed_;
+  }
+
+  void set_seed(const uint64_t seed) noexcept {
+    seed_ = seed;
+  }
+
+  /// \brief Number of balanced boards to generate one after another. Always at
+  /// least 1.
+  uint32_t number_of_boards() const noexcept {
+    return number_of_boards_;
+  }
+
+  void set_number_of_boards(const uint32_t number_of_boards) noexcept {
+    number_of_boards_ = std::max(uint32_t{1}, number_of_boards);
+  }
+
+  /// \brief Number of options kept for each board: the best valid boards found
+  /// during its search that are not near-duplicates of each other. Always at
+  /// least 1.
+  uint16_t number_of_options() const noexcept {
+    return number_of_options_;
+  }
+
+  void set_number_of_options(const uint16_t number_of_options) noexcept {
+    number_of_options_ = std::max(uint16_t{1}, number_of_options);
+  }
+
+  /// \brief Minimum number of positions in which two options of the same board
+  /// must differ.
+  uint8_t minimum_option_distance() const noexcept {
+    return minimum_option_distance_;
+  }
+
+  void set_minimum_option_distance(
+      const uint8_t minimum_option_distance) noexcept {
+    minimum_option_distance_ = minimum_option_distance;
+  }
+
+  /// \brief A value of 0 selects one worker thread per available hardware
+  /// thread.
+  void set_number_of_threads(const uint16_t number_of_threads) noexcept {
+    if (number_of_threads == 0) {
+      number_of_threads_ = static_cast<uint16_t>(
+          std::max(1U, std::thread::hardware_concurrency()));
+    } else {
+      number_of_threads_ = number_of_threads;
+    }
+  }
+
+private:
+  GameVersion game_version_{
+      GameVersion::ProphecyOfKingsAndThundersEdgeExpansions};
+
+  Layout layout_{Layout::Players6Regular};
+
+  Aggression aggression_{Aggression::Moderate};
+
+  Search search_{Search::Random};
+
+  uint16_t number_of_threads_{1};
+
+  uint32_t number_of_boards_{1};
+
+  uint16_t number_of_options_{1};
+
+  uint8_t minimum_option_distance_{1};
+
+  uint64_t seed_{0};
+
+  uint64_t time_limit_milliseconds_{0};
+
+  bool stats_{false};
+
+};  // class Settings
+
+}  // namespace TI4Cartographer
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Systems.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Dense index of a system in the system catalog.
+using SystemIndex = uint16_t;
+
+/// \brief Index of a tile whose system is not in the catalog, such as a home
+/// tile or a skipped tile.
+constexpr const SystemIndex NoSystemIndex{
+    std::numeric_limits<SystemIndex>::max()};
+
+/// \brief Bit flags of the properties of a system in the system catalog.
+constexpr const uint8_t SystemContainsAnomaly{1};
+constexpr const uint8_t SystemContainsAlphaWormhole{2};
+constexpr const uint8_t SystemContainsBetaWormhole{4};
+constexpr const uint8_t SystemContainsWormhole{8};
+constexpr const uint8_t SystemContainsSupernova{16};
+constexpr const uint8_t SystemContainsGravityRift{32};
+constexpr const uint8_t SystemContainsNebula{64};
+constexpr const uint8_t SystemContainsPlanets{128};
+
+/// \brief Compiled form of the Systems collection. Each system is given a
+/// dense index, in order of system ID, and the attributes used while
+/// generating boards are stored in flat arrays indexed by system index. String
+/// system IDs are only needed for input and output.
+class SystemCatalog {
+public:
+  SystemCatalog() noexcept {
+    for (const System& system : Systems) {
+      systems_.push_back(&system);
+    }
+    std::sort(systems_.begin(), systems_.end(),
+              [](const System* system_1, const System* system_2) -> bool {
+                return System::sort_by_id()(*system_1, *system_2);
+              });
+    for (std::size_t index = 0; index < systems_.size(); ++index) {
+      const System& system{*systems_[index]};
+      ids_to_indices_.emplace(system.id(), static_cast<SystemIndex>(index));
+      categories_.push_back(system.category());
+      flags_.push_back(initial_flags(system));
+      numbers_of_planets_.push_back(
+          static_cast<uint8_t>(system.planets().size()));
+      float useful_resources{0.0f};
+      float useful_influence{0.0f};
+      for (const Planet& planet : system.planets()) {
+        useful_resources += planet.useful_resources();
+        useful_influence += planet.useful_influence();
+      }
+      useful_resources_.push_back(useful_resources);
+      useful_influence_.push_back(useful_influence);
+      scores_.push_back(system.score());
+      expansion_scores_.push_back(system.expansion_score());
+    }
+  }
+
+  std::size_t size() const noexcept {
+    return systems_.size();
+  }
+
+  /// \brief Returns the index of the system with the given ID, or NoSystemIndex
+  /// if there is no such system.
+  SystemIndex index(const std::string& id) const noexcept {
+    const std::unordered_map<std::string, SystemIndex>::const_iterator
+        id_and_index{ids_to_indices_.find(id)};
+    if (id_and_index != ids_to_indices_.cend()) {
+      return id_and_index->second;
+    }
+    return NoSystemIndex;
+  }
+
+  const System& system(const SystemIndex index) const noexcept {
+    return *systems_[index];
+  }
+
+  const std::string& id(const SystemIndex index) const noexcept {
+    return systems_[index]->id();
+  }
+
+  SystemCategory category(const SystemIndex index) const noexcept {
+    return categories_[index];
+  }
+
+  /// \brief Combination of the SystemContains bit flags of the system.
+  uint8_t flags(const SystemIndex index) const noexcept {
+    return flags_[index];
+  }
+
+  uint8_t number_of_planets(const SystemIndex index) const noexcept {
+    return numbers_of_planets_[index];
+  }
+
+  /// \brief Sum of the useful resources of the planets of the system.
+  float useful_resources(const SystemIndex index) const noexcept {
+    return useful_resources_[index];
+  }
+
+  /// \brief Sum of the useful influence of the planets of the system.
+  float useful_influence(const SystemIndex index) const noexcept {
+    return useful_influence_[index];
+  }
+
+  float score(const SystemIndex index) const noexcept {
+    return scores_[index];
+  }
+
+  float expansion_score(const SystemIndex index) const noexcept {
+    return expansion_scores_[index];
+  }
+
+private:
+  std::unordered_map<std::string, SystemIndex> ids_to_indices_;
+
+  std::vector<const System*> systems_;
+
+  std::vector<SystemCategory> categories_;
+
+  std::vector<uint8_t> flags_;
+
+  std::vector<uint8_t> numbers_of_planets_;
+
+  std::vector<float> useful_resources_;
+
+  std::vector<float> useful_influence_;
+
+  std::vector<float> scores_;
+
+  std::vector<float> expansion_scores_;
+
+  static uint8_t initial_flags(const System& system) noexcept {
+    uint8_t flags{0};
+    if (system.contains_one_or_more_anomalies()) {
+      flags |= SystemContainsAnomaly;
+    }
+    if (system.contains(Wormhole::Alpha)) {
+      flags |= SystemContainsAlphaWormhole;
+    }
+    if (system.contains(Wormhole::Beta)) {
+      flags |= SystemContainsBetaWormhole;
+    }
+    if (system.contains_one_or_more_wormholes()) {
+      flags |= SystemContainsWormhole;
+    }
+    if (system.contains(Anomaly::Supernova)) {
+      flags |= SystemContainsSupernova;
+    }
+    if (system.contains(Anomaly::GravityRift)) {
+      flags |= SystemContainsGravityRift;
+    }
+    if (system.contains(Anomaly::Nebula)) {
+      flags |= SystemContainsNebula;
+    }
+    if (!system.planets().empty()) {
+      flags |= SystemContainsPlanets;
+    }
+    return flags;
+  }
+
+};  // class SystemCatalog
+
+/// \brief Catalog of all systems. Must be defined after Systems.
+const SystemCatalog Catalog{};
+
+}  // namespace TI4Cartographer
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "BestBoard.hpp"
+#include "SearchCounters.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Parallel tempering, also known as replica exchange. Runs several
+/// replicas of a board, each at its own temperature of a geometric ladder that
+/// goes from the target score imbalance down to a small fraction of it. In
+/// each round, every replica makes a number of annealing swaps at its
+/// temperature, with the replicas spread over the threads. Between rounds, the
+/// replicas at neighboring temperatures exchange their temperatures with the
+/// usual Metropolis criterion, so that good boards found by the hot replicas
+/// move down to the cold replicas that refine them. Exchanging temperatures
+/// rather than boards costs nothing. All replicas arrange the same selected
+/// systems.
+/// \details The board type is a template parameter so that the board can
+/// include this header and run this search on itself.
+template <typename Board>
+class TemperingSearch {
+public:
+  explicit TemperingSearch(Board& board) noexcept : board_(board) {}
+
+  template <bool Instrumented>
+  void run(const float score_imbalance_ratio_tolerance, BestBoard& best_board) {
+    const std::size_t number_of_threads{
+        std::max<std::size_t>(board_.number_of_threads_, 1)};
+    std::vector<Replica> replicas(
+        std::max(number_of_threads, minimum_number_of_replicas_),
+        Replica{board_});
+    for (Replica& replica : replicas) {
+      replica.board.random_engine_.seed(board_.random_engine_());
+      replica.board.total_number_of_iterations_ = 0;
+      replica.board.total_number_of_valid_boards_ = 0;
+      replica.board.search_counters_ = {};
+    }
+    // Temperature of each rung of the ladder, hottest first, and replica
+    // currently at each rung.
+    std::vector<float> temperatures(replicas.size());
+    std::vector<std::size_t> rungs_to_replicas(replicas.size());
+    for (std::size_t rung = 0; rung < replicas.size(); ++rung) {
+      temperatures[rung] =
+          score_imbalance_ratio_tolerance
+          * std::pow(lowest_temperature_ratio_,
+                     static_cast<float>(rung)
+                         / static_cast<float>(replicas.size() - 1));
+      rungs_to_replicas[rung] = rung;
+    }
+    const auto run_rungs{[&](const std::size_t first_rung) {
+      for (std::size_t rung = first_rung; rung < replicas.size();
+           rung += number_of_threads) {
+        sample<Instrumented>(replicas[rungs_to_replicas[rung]],
+                             temperatures[rung],
+                             score_imbalance_ratio_tolerance, best_board);
+      }
+    }};
+    uint64_t number_of_rounds{0};
+    uint64_t number_of_exchanges{0};
+    uint64_t number_of_accepted_exchanges{0};
+    bool success{false};
+    bool stopped_by_deadline{false};
+    while (number_of_rounds * exchange_interval_
+           < Board::maximum_number_of_iterations_per_attempt_) {
+      ++number_of_rounds;
+      if (number_of_threads == 1) {
+        run_rungs(0);
+      } else {
+        std::vector<std::thread> threads;
+        for (std::size_t thread = 0; thread < number_of_threads; ++thread) {
+          threads.emplace_back(run_rungs, thread);
+        }
+        for (std::thread& thread : threads) {
+          thread.join();
+        }
+      }
+      if (best_board.score_imbalance_ratio()
+          <= score_imbalance_ratio_tolerance) {
+        success = true;
+        break;
+      }
+      if (board_.deadline_.expired()) {
+        stopped_by_deadline = true;
+        break;
+      }
+      // Alternate between the even and the odd pairs of neighboring rungs.
+      for (std::size_t rung = number_of_rounds % 2; rung + 1 < replicas.size();
+           rung += 2) {
+        const Replica& hotter{replicas[rungs_to_replicas[rung]]};
+        const Replica& colder{replicas[rungs_to_replicas[rung + 1]]};
+        if (!hotter.board_is_valid || !colder.board_is_valid) {
+          continue;
+        }
+        ++number_of_exchanges;
+        const float exponent{
+            (colder.score_imbalance_ratio - hotter.score_imbalance_ratio)
+            * (1.0f / temperatures[rung + 1] - 1.0f / temperatures[rung])};
+        if (exponent >= 0.0f
+            || board_.random_engine_.uniform() < std::exp(exponent)) {
+          ++number_of_accepted_exchanges;
+          std::swap(rungs_to_replicas[rung], rungs_to_replicas[rung + 1]);
+        }
+      }
+    }
+    uint64_t number_of_iterations{0};
+    uint64_t number_of_valid_boards{0};
+    uint64_t number_of_accepted_swaps{0};
+    for (const Replica& replica : replicas) {
+      number_of_iterations += replica.board.total_number_of_iterations_;
+      number_of_valid_boards += replica.board.total_number_of_valid_boards_;
+      number_of_accepted_swaps += replica.number_of_accepted_swaps;
+      board_.search_counters_ += replica.board.search_counters_;
+    }
+    board_.total_number_of_iterations_ += number_of_iterations;
+    board_.total_number_of_valid_boards_ += number_of_valid_boards;
+    // Message after iterations are complete.
+    const std::string summary{
+        std::to_string(number_of_iterations) + " iterations of "
+        + std::to_string(replicas.size()) + " replicas with "
+        + std::to_string(number_of_accepted_swaps) + " accepted swaps and "
+        + std::to_string(number_of_accepted_exchanges) + " of "
+        + std::to_string(number_of_exchanges) + " exchanges accepted"};
+    if (success) {
+      verbose_message("Found an optimal game board after " + summary + ".");
+    } else if (stopped_by_deadline) {
+      verbose_message("Stopped after " + summary
+                      + " because the time limit was reached or a stop was "
+                        "requested.");
+    } else {
+      verbose_message(
+          "No optimal game board with a score imbalance of "
+          + score_imbalance_ratio_to_string(score_imbalance_ratio_tolerance)
+          + " or less could be found after " + summary + ".");
+    }
+  }
+
+private:
+  /// \brief The search runs at least this many replicas, even on a single
+  /// thread, so that its temperature ladder spans a useful range of
+  /// temperatures.
+  static constexpr const std::size_t minimum_number_of_replicas_{4};
+
+  /// \brief Number of swaps that each replica makes between two rounds of
+  /// exchanges.
+  static constexpr const uint64_t exchange_interval_{1000};
+
+  /// \brief Ratio of the lowest temperature to the highest temperature of the
+  /// temperature ladder.
+  static constexpr const float lowest_temperature_ratio_{0.01};
+
+  /// \brief Copy of the board that runs at one temperature of the ladder.
+  struct Replica {
+    Board board;
+
+    /// \brief If true, the board holds a valid arrangement. Otherwise, the
+    /// replica is still looking for one.
+    bool board_is_valid{false};
+
+    /// \brief Score imbalance of the arrangement that the board holds.
+    float score_imbalance_ratio{0.0f};
+
+    uint64_t number_of_accepted_swaps{0};
+  };
+
+  Board& board_;
+
+  /// \brief Runs one round of one replica: makes annealing swaps at the given
+  /// temperature, or looks for a valid board to start from if the replica
+  /// does not hold one yet.
+  template <bool Instrumented>
+  void sample(Replica& replica, const float temperature,
+              const float score_imbalance_ratio_tolerance,
+              BestBoard& best_board) {
+    Board& board{replica.board};
+    uint64_t number_of_iterations{0};
+    uint64_t number_of_valid_boards{0};
+    bool success{false};
+    if (replica.board_is_valid) {
+      // Discard any floating-point drift of the incremental scorer.
+      board.initialize_incremental_player_scores();
+      board.score_imbalance_ratio_ = board.score_imbalance_ratio();
+    } else {
+      bool stopped_by_deadline{false};
+      replica.board_is_valid =
+          board.template generate_valid_board<Instrumented>(
+              exchange_interval_, number_of_iterations, stopped_by_deadline);
+      if (replica.board_is_valid) {
+        ++number_of_valid_boards;
+      }
+      if (replica.board_is_valid || best_board.empty()) {
+        success = board.update_best_board_and_return_success(
+            score_imbalance_ratio_tolerance, best_board,
+            board.total_number_of_iterations_ + number_of_iterations,
+            replica.board_is_valid);
+      }
+    }
+    float current_score_imbalance_ratio{board.score_imbalance_ratio_};
+    while (replica.board_is_valid && !success
+           && number_of_iterations < exchange_interval_) {
+      if (best_board.score_imbalance_ratio()
+          <= score_imbalance_ratio_tolerance) {
+        break;
+      }
+      if ((number_of_iterations & Board::deadline_check_mask_) == 0
+          && board.deadline_.expired()) {
+        break;
+      }
+      ++number_of_iterations;
+      const std::pair<uint8_t, uint8_t> indices{board.random_swap()};
+      board.template swap_system_ids_and_update_player_scores<Instrumented>(
+          indices.first, indices.second);
+      if (!board.template iteration_is_valid<Instrumented>()) {
+        board.template swap_system_ids_and_update_player_scores<Instrumented>(
+            indices.first, indices.second);
+        continue;
+      }
+      ++number_of_valid_boards;
+      board.score_imbalance_ratio_ = board.score_imbalance_ratio();
+      if (board.score_imbalance_ratio_ <= current_score_imbalance_ratio
+          || board.random_engine_.uniform()
+                 < std::exp((current_score_imbalance_ratio
+                             - board.score_imbalance_ratio_)
+                            / temperature)) {
+        ++replica.number_of_accepted_swaps;
+        current_score_imbalance_ratio = board.score_imbalance_ratio_;
+        if (board.score_imbalance_ratio_
+            < best_board.score_imbalance_ratio()) {
+          success = board.update_best_board_and_return_success(
+              score_imbalance_ratio_tolerance, best_board,
+              board.total_number_of_iterations_ + number_of_iterations);
+        }
+      } else {
+        board.template swap_system_ids_and_update_player_scores<Instrumented>(
+            indices.first, indices.second);
+      }
+    }
+    // Leave the board's scores consistent with the board it holds.
+    board.score_imbalance_ratio_ = current_score_imbalance_ratio;
+    replica.score_imbalance_ratio = current_score_imbalance_ratio;
+    board.total_number_of_iterations_ += number_of_iterations;
+    board.total_number_of_valid_boards_ += number_of_valid_boards;
+    if constexpr (Instrumented) {
+      board.search_counters_.add_iterations(
+          number_of_iterations, number_of_valid_boards);
+    }
+  }
+};  // class TemperingSearch
+
+}  // namespace TI4Cartographer
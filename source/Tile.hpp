@@ -2,7 +2,7 @@
 
 #include "Player.hpp"
 #include "Position.hpp"
-#include "Systems.hpp"
+#include "SystemCatalog.hpp"
 
 namespace TI4Cartographer {
 
@@ -22,6 +22,7 @@ public:
       system_categories_.insert(SystemCategory::AnomalyWormholeEmpty);
       is_planetary_anomaly_wormhole_or_empty_ = true;
     }
+    system_index_ = Catalog.index(system_id_);
   }
 
   /// \brief Constructor for a home system.
@@ -32,6 +33,7 @@ public:
     system_categories_.insert(SystemCategory::Home);
     system_categories_.insert(SystemCategory::CreussGate);
     system_id_ = "0";
+    system_index_ = Catalog.index(system_id_);
   }
 
   /// \brief Constructor for a hyperlane system or a skipped tile. System ID -1
@@ -51,10 +53,20 @@ public:
         error("System " + system->print() + " is not a hyperlane. Trying to assign this system to the tile at position " + position.print() + ".");
       }
     }
+    system_index_ = Catalog.index(system_id_);
   }
 
   void set_system_id(const std::string& system_id) {
     system_id_ = system_id;
+    system_index_ = Catalog.index(system_id_);
+    check_system_category();
+  }
+
+  /// \brief Faster alternative to set_system_id() for systems that are in the
+  /// system catalog. The system ID string is only looked up when printing.
+  void set_system_index(const SystemIndex system_index) {
+    system_index_ = system_index;
+    system_id_.clear();
     check_system_category();
   }
 
@@ -88,9 +100,18 @@ public:
   }
 
   const std::string& system_id() const noexcept {
+    if (system_index_ != NoSystemIndex) {
+      return Catalog.id(system_index_);
+    }
     return system_id_;
   }
 
+  /// \brief Index of this tile's system in the system catalog, or
+  /// NoSystemIndex if its system is not in the catalog.
+  SystemIndex system_index() const noexcept {
+    return system_index_;
+  }
+
   const std::optional<Player>& home_player() const noexcept {
     return home_player_;
   }
@@ -120,7 +141,7 @@ public:
   }
 
   std::string print() const noexcept {
-    return position_.print() + " " + system_id_;
+    return position_.print() + " " + system_id();
   }
 
 private:
@@ -134,20 +155,22 @@ private:
 
   std::set<Position> hyperlane_neighbors_;
 
+  /// \brief System ID as given. Only returned by system_id() if the system is
+  /// not in the system catalog.
   std::string system_id_;
 
+  SystemIndex system_index_{NoSystemIndex};
+
   /// \brief If this tile is a home system or the Creuss Gate system, this is
   /// the player whose system this is.
   std::optional<Player> home_player_;
 
   void check_system_category() const {
-    const std::unordered_set<System>::const_iterator system{
-        Systems.find({system_id_})};
-    if (system != Systems.cend()) {
+    if (system_index_ != NoSystemIndex) {
       const std::set<SystemCategory>::const_iterator system_category{
-          system_categories_.find(system->category())};
+          system_categories_.find(Catalog.category(system_index_))};
       if (system_category == system_categories_.cend()) {
-        error("System " + system->print()
+        error("System " + Catalog.system(system_index_).print()
               + " is of the wrong type for the tile at position "
               + position_.print() + ".");
       }
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Tile.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Tiles of a game board stored contiguously in order of position
+/// ordinal, with a fixed lookup table from position ordinal to tile. Finding
+/// the tile at a position is a plain array access.
+class TileArray {
+public:
+  TileArray() noexcept {
+    ordinals_to_indices_.fill(no_index_);
+  }
+
+  /// \brief Inserts a tile. If a tile already exists at its position, it is
+  /// replaced.
+  void insert(const Tile& tile) noexcept {
+    const uint8_t ordinal{tile.position().ordinal()};
+    if (ordinals_to_indices_[ordinal] != no_index_) {
+      tiles_[ordinals_to_indices_[ordinal]] = tile;
+      return;
+    }
+    tiles_.insert(
+        std::upper_bound(tiles_.begin(), tiles_.end(), tile,
+                         [](const Tile& tile_1, const Tile& tile_2) -> bool {
+                           return tile_1.position().ordinal()
+                                  < tile_2.position().ordinal();
+                         }),
+        tile);
+    ordinals_to_indices_.fill(no_index_);
+    for (std::size_t index = 0; index < tiles_.size(); ++index) {
+      ordinals_to_indices_[tiles_[index].position().ordinal()] =
+          static_cast<uint8_t>(index);
+    }
+  }
+
+  /// \brief Returns the tile at the given position, or nullptr if there is no
+  /// tile at this position.
+  const Tile* find(const Position& position) const noexcept {
+    return find(position.ordinal());
+  }
+
+  /// \brief Returns the tile at the position with the given ordinal, or
+  /// nullptr if there is no tile at this position.
+  const Tile* find(const uint8_t ordinal) const noexcept {
+    if (ordinal >= ordinals_to_indices_.size()
+        || ordinals_to_indices_[ordinal] == no_index_) {
+      return nullptr;
+    }
+    return &tiles_[ordinals_to_indices_[ordinal]];
+  }
+
+  /// \brief Returns the tile at the given position, or nullptr if there is no
+  /// tile at this position.
+  Tile* find(const Position& position) noexcept {
+    return find(position.ordinal());
+  }
+
+  /// \brief Returns the tile at the position with the given ordinal, or
+  /// nullptr if there is no tile at this position.
+  Tile* find(const uint8_t ordinal) noexcept {
+    if (ordinal >= ordinals_to_indices_.size()
+        || ordinals_to_indices_[ordinal] == no_index_) {
+      return nullptr;
+    }
+    return &tiles_[ordinals_to_indices_[ordinal]];
+  }
+
+  bool empty() const noexcept {
+    return tiles_.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return tiles_.size();
+  }
+
+  std::vector<Tile>::const_iterator begin() const noexcept {
+    return tiles_.cbegin();
+  }
+
+  std::vector<Tile>::const_iterator end() const noexcept {
+    return tiles_.cend();
+  }
+
+  std::vector<Tile>::iterator begin() noexcept {
+    return tiles_.begin();
+  }
+
+  std::vector<Tile>::iterator end() noexcept {
+    return tiles_.end();
+  }
+
+private:
+  static constexpr const uint8_t no_index_{
+      std::numeric_limits<uint8_t>::max()};
+
+  std::vector<Tile> tiles_;
+
+  std::array<uint8_t, 64> ordinals_to_indices_;
+
+};  // class TileArray
+
+}  // namespace TI4Cartographer
@@ -0,0 +1,185 @@
+#include "BoardInitializer.hpp"
+#include "Topology.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Computes the topology of a board layout by searching its tiles and
+/// prints it as the C++ source code of a Topology table.
+class Topographer : public BoardInitializer {
+public:
+  Topographer(const Layout layout) noexcept
+    : BoardInitializer(layout), layout_(layout) {}
+
+  /// \brief Initializer of the Topology table.
+  std::string print_topology() const noexcept {
+    std::array<uint64_t, 64> neighbors{};
+    std::array<int8_t, 64> distances_from_mecatol_rex;
+    distances_from_mecatol_rex.fill(NoTopologyDistance);
+    std::array<std::array<int8_t, 9>, 64> distances_from_players_homes;
+    for (std::array<int8_t, 9>& distances : distances_from_players_homes) {
+      distances.fill(NoTopologyDistance);
+    }
+    std::array<uint16_t, 64> relevant_players{};
+    for (const std::pair<const Position, std::set<Position>>&
+             position_and_neighbors : neighbors_) {
+      neighbors[position_and_neighbors.first.ordinal()] =
+          mask(position_and_neighbors.second);
+    }
+    for (const std::pair<const Position, Distance>& position_and_distance :
+         positions_to_distances_from_mecatol_rex_) {
+      distances_from_mecatol_rex[position_and_distance.first.ordinal()] =
+          position_and_distance.second.value();
+    }
+    for (const std::pair<const Position, std::map<Player, Distance>>&
+             position_and_distances : positions_to_players_home_distances_) {
+      for (const std::pair<const Player, Distance>& player_and_distance :
+           position_and_distances.second) {
+        distances_from_players_homes[position_and_distances.first.ordinal()]
+                                    [static_cast<uint8_t>(
+                                        player_and_distance.first)] =
+            player_and_distance.second.value();
+      }
+    }
+    for (const std::pair<const Position, std::set<Player>>&
+             position_and_players : positions_to_relevant_players_) {
+      relevant_players[position_and_players.first.ordinal()] =
+          mask(position_and_players.second);
+    }
+    std::string text{"    // " + label(layout_) + "\n    Topology{\n"};
+    text += "        {" + print_numbers(neighbors) + "},\n";
+    text += "        {" + print_numbers(distances_from_mecatol_rex) + "},\n";
+    text += "        {{";
+    for (std::size_t index = 0; index < distances_from_players_homes.size();
+         ++index) {
+      if (index > 0) {
+        text += ", ";
+      }
+      text += "{" + print_numbers(distances_from_players_homes[index]) + "}";
+    }
+    text += "}},\n";
+    text += "        {" + print_numbers(relevant_players) + "},\n";
+    text += "        {" + print_numbers(masks(players_to_forward_positions_))
+            + "},\n";
+    text += "        {" + print_numbers(masks(players_to_lateral_positions_))
+            + "},\n";
+    text += "        "
+            + std::to_string(
+                players_mask(players_to_preferred_expansion_positions_))
+            + ",\n";
+    text += "        {"
+            + print_numbers(masks(players_to_preferred_expansion_positions_))
+            + "},\n";
+    text += "        "
+            + std::to_string(
+                players_mask(players_to_alternate_expansion_positions_))
+            + ",\n";
+    text += "        {"
+            + print_numbers(masks(players_to_alternate_expansion_positions_))
+            + "},\n";
+    text += "        {"
+            + print_numbers(masks(players_to_mecatol_rex_pathway_positions_))
+            + "},\n    }";
+    return text;
+  }
+
+private:
+  Layout layout_;
+
+  static uint64_t mask(const std::set<Position>& positions) noexcept {
+    Bitboard bitboard;
+    for (const Position& position : positions) {
+      bitboard.insert(position);
+    }
+    return bitboard.mask();
+  }
+
+  static uint16_t mask(const std::set<Player>& players) noexcept {
+    uint16_t mask_{0};
+    for (const Player player : players) {
+      mask_ |= static_cast<uint16_t>(1U << static_cast<uint8_t>(player));
+    }
+    return mask_;
+  }
+
+  static std::array<uint64_t, 9> masks(const std::map<Player, std::set<Position>>&
+                                          players_to_positions) noexcept {
+    std::array<uint64_t, 9> masks_{};
+    for (const std::pair<const Player, std::set<Position>>&
+             player_and_positions : players_to_positions) {
+      masks_[static_cast<uint8_t>(player_and_positions.first)] =
+          mask(player_and_positions.second);
+    }
+    return masks_;
+  }
+
+  static uint16_t players_mask(const std::map<Player, std::set<Position>>&
+                                   players_to_positions) noexcept {
+    uint16_t mask_{0};
+    for (const std::pair<const Player, std::set<Position>>&
+             player_and_positions : players_to_positions) {
+      mask_ |= static_cast<uint16_t>(
+          1U << static_cast<uint8_t>(player_and_positions.first));
+    }
+    return mask_;
+  }
+
+  template <typename Number>
+  static std::string print_numbers(const Number& numbers) noexcept {
+    std::string text;
+    for (const auto number : numbers) {
+      if (!text.empty()) {
+        text += ", ";
+      }
+      text += std::to_string(number);
+      if (sizeof(number) == sizeof(uint64_t)) {
+        text += "U";
+      }
+    }
+    return text;
+  }
+
+};  // class Topographer
+
+}  // namespace TI4Cartographer
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <path to the generated header>"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  TI4Cartographer::Communicator::get().initialize(
+      TI4Cartographer::CommunicatorMode::Quiet);
+
+  std::string topologies;
+  for (uint8_t layout_value = 0;
+       layout_value
+       <= static_cast<uint8_t>(TI4Cartographer::Layout::Players8Large);
+       ++layout_value) {
+    const TI4Cartographer::Topographer topographer{
+        static_cast<TI4Cartographer::Layout>(layout_value)};
+    topologies += topographer.print_topology() + ",\n";
+  }
+
+  std::ofstream stream{argv[1]};
+  stream << "// Generated by the ti4topographer program. Do not edit.\n\n"
+         << "#pragma once\n\n"
+         << "#include \"Topology.hpp\"\n\n"
+         << "namespace TI4Cartographer {\n\n"
+         << "/// \\brief Topology of each board layout, indexed by layout.\n"
+         << "constexpr const std::array<Topology, "
+         << std::to_string(static_cast<uint8_t>(
+                               TI4Cartographer::Layout::Players8Large)
+                           + 1)
+         << "> Topologies{\n"
+         << topologies << "};\n\n"
+         << "}  // namespace TI4Cartographer\n";
+  stream.close();
+  if (!stream) {
+    std::cerr << "Cannot write the generated header: " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Base.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Distance stored in a topology table for a position that cannot be
+/// reached, or that is not on the board.
+constexpr const int8_t NoTopologyDistance{-1};
+
+/// \brief Precomputed topology of one board layout. Every attribute is a pure
+/// function of the layout's tiles, so these tables are generated at build time
+/// by the ti4topographer program and compiled into the other programs. Sets
+/// of positions are 64-bit masks indexed by position ordinal, and sets of
+/// players are 16-bit masks indexed by player number. Tables indexed by player
+/// have 9 entries so that they can be indexed directly by player number.
+struct Topology {
+  /// \brief Neighbors of each position. Only meaningful for positions that
+  /// hold a tile that is not a hyperlane.
+  std::array<uint64_t, 64> neighbors;
+
+  /// \brief Distance of each position from Mecatol Rex, or NoTopologyDistance.
+  std::array<int8_t, 64> distances_from_mecatol_rex;
+
+  /// \brief Distance of each position from each player's home, or
+  /// NoTopologyDistance.
+  std::array<std::array<int8_t, 9>, 64> distances_from_players_homes;
+
+  /// \brief Relevant players of each planetary/anomaly/wormhole/empty
+  /// position.
+  std::array<uint16_t, 64> relevant_players;
+
+  std::array<uint64_t, 9> forward_positions;
+
+  std::array<uint64_t, 9> lateral_positions;
+
+  /// \brief Players who have preferred expansion positions, which may be an
+  /// empty set.
+  uint16_t preferred_expansion_players;
+
+  std::array<uint64_t, 9> preferred_expansion_positions;
+
+  /// \brief Players who have alternate expansion positions, which may be an
+  /// empty set.
+  uint16_t alternate_expansion_players;
+
+  std::array<uint64_t, 9> alternate_expansion_positions;
+
+  /// \brief Positions along the shortest pathways to Mecatol Rex.
+  std::array<uint64_t, 9> mecatol_rex_pathway_positions;
+
+};  // struct Topology
+
+}  // namespace TI4Cartographer
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "RandomEngine.hpp"
+#include "SystemCatalog.hpp"
+
+namespace TI4Cartographer {
+
+/// \brief Fixed-size cache of the boards already seen by a search, keyed by
+/// their Zobrist hash. The hash of a board is the exclusive or of one random
+/// key per pair of position ordinal and system index. Each slot stores its
+/// entry and the exclusive or of its entry and its hash in two atomic words,
+/// so that workers can share the table without locks: a slot whose words were
+/// written by two workers at once no longer matches any hash and is simply a
+/// miss. A newer entry replaces the older entry of its slot.
+class TranspositionTable {
+public:
+  /// \brief Whether a board is valid and, if so, its score imbalance.
+  struct Entry {
+    bool is_valid{false};
+
+    float score_imbalance_ratio{0.0f};
+  };
+
+  TranspositionTable() noexcept
+    : keys_(64 * Catalog.size()), slots_(new Slot[number_of_slots_]) {
+    RandomEngine random_engine{keys_seed_};
+    for (uint64_t& key : keys_) {
+      key = random_engine();
+    }
+  }
+
+  /// \brief Key of the given system on the given position. The keys of one
+  /// system on every position are contiguous, since hashing a board under each
+  /// symmetry of its board layout looks up one system on several positions.
+  uint64_t key(const uint8_t ordinal, const SystemIndex system) const noexcept {
+    return keys_[system * std::size_t{64} + ordinal];
+  }
+
+  /// \brief Returns the entry of the board with the given hash, or nothing if
+  /// the board is not in the table.
+  std::optional<Entry> probe(const uint64_t hash) const noexcept {
+    const Slot& slot{slots_[hash & (number_of_slots_ - 1)]};
+    const uint64_t data{slot.data.load(std::memory_order_relaxed)};
+    const uint64_t check{slot.check.load(std::memory_order_relaxed)};
+    if ((data & occupied_) == 0 || (check ^ data) != hash) {
+      return std::nullopt;
+    }
+    float score_imbalance_ratio;
+    const uint32_t bits{static_cast<uint32_t>(data)};
+    std::memcpy(&score_imbalance_ratio, &bits, sizeof(bits));
+    return Entry{(data & valid_) != 0, score_imbalance_ratio};
+  }
+
+  /// \brief Stores the entry of the board with the given hash.
+  void store(const uint64_t hash, const Entry& entry) noexcept {
+    uint32_t bits;
+    std::memcpy(&bits, &entry.score_imbalance_ratio, sizeof(bits));
+    const uint64_t data{occupied_ | (entry.is_valid ? valid_ : 0) | bits};
+    Slot& slot{slots_[hash & (number_of_slots_ - 1)]};
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(hash ^ data, std::memory_order_relaxed);
+  }
+
+private:
+  /// \brief Must be a power of two.
+  static constexpr const std::size_t number_of_slots_{std::size_t{1} << 16};
+
+  /// \brief The keys are the same in every run so that hashes are
+  /// reproducible.
+  static constexpr const uint64_t keys_seed_{0x5A0B6E57C0FFEEULL};
+
+  static constexpr const uint64_t occupied_{uint64_t{1} << 33};
+
+  static constexpr const uint64_t valid_{uint64_t{1} << 32};
+
+  struct Slot {
+    std::atomic<uint64_t> check{0};
+
+    std::atomic<uint64_t> data{0};
+  };
+
+  std::vector<uint64_t> keys_;
+
+  std::unique_ptr<Slot[]> slots_;
+
+};  // class TranspositionTable
+
+}  // namespace TI4Cartographer
@@ -0,0 +1,4 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+../build/bin/ti4cartographer --players 6 --layout regular --aggression moderate --search annealing
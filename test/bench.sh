@@ -0,0 +1,6 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+../build/bin/ti4bench --players 8 --output ../build/ti4bench_baseline.csv
+../build/bin/ti4bench --players 8 --output ../build/ti4bench.csv --baseline ../build/ti4bench_baseline.csv
+test "$(wc -l < ../build/ti4bench.csv)" -eq "$(wc -l < ../build/ti4bench_baseline.csv)"
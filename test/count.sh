@@ -0,0 +1,4 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+test "$(../build/bin/ti4cartographer --players 6 --layout regular --search annealing --count 3 --quiet | wc -l)" -eq 3
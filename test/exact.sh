@@ -0,0 +1,4 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+../build/bin/ti4cartographer --players 3 --layout small --search exact --seed 1 | grep -q "provably optimal"
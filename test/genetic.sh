@@ -0,0 +1,14 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+output="$(../build/bin/ti4cartographer --players 6 --layout regular --aggression moderate --search genetic --threads 2 --seed 1)"
+target="$(printf '%s\n' "${output}" | sed -n 's/.*target score imbalance: \([0-9.]*\) %$/\1/p' | tail -n 1)"
+imbalance="$(printf '%s\n' "${output}" | sed -n 's/^Score imbalance: \([0-9.]*\) %$/\1/p')"
+test -n "${imbalance}"
+test -n "${target}"
+awk -v imbalance="${imbalance}" -v target="${target}" 'BEGIN { exit !(imbalance <= target) }'
+# The fitness is evaluated in parallel, but the evolution itself only depends
+# on the seed, so the number of threads does not change the board.
+single="$(../build/bin/ti4cartographer --players 6 --layout regular --aggression moderate --search genetic --threads 1 --seed 1 --quiet)"
+parallel="$(../build/bin/ti4cartographer --players 6 --layout regular --aggression moderate --search genetic --threads 4 --seed 1 --quiet)"
+test "${single}" = "${parallel}"
@@ -0,0 +1,13 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+output="$(../build/bin/ti4cartographer --players 8 --layout large --aggression moderate --search partition --seed 1)"
+target="$(printf '%s\n' "${output}" | sed -n 's/.*target score imbalance: \([0-9.]*\) %$/\1/p' | tail -n 1)"
+imbalance="$(printf '%s\n' "${output}" | sed -n 's/^Score imbalance: \([0-9.]*\) %$/\1/p')"
+test -n "${imbalance}"
+test -n "${target}"
+awk -v imbalance="${imbalance}" -v target="${target}" 'BEGIN { exit !(imbalance <= target) }'
+first="$(../build/bin/ti4cartographer --players 8 --layout large --aggression moderate --search partition --seed 1 --quiet)"
+second="$(../build/bin/ti4cartographer --players 8 --layout large --aggression moderate --search partition --seed 1 --quiet)"
+test "${first}" = "${second}"
+test "$(printf '%s\n' "${output}" | sed -n 's/^Tabletop Simulator string: //p')" = "${first}"
@@ -0,0 +1,6 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+first="$(../build/bin/ti4cartographer --players 6 --layout regular --search annealing --seed 42 --quiet)"
+second="$(../build/bin/ti4cartographer --players 6 --layout regular --search annealing --seed 42 --quiet)"
+test "${first}" = "${second}"
@@ -0,0 +1,36 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+socket=../build/serve_test.sock
+rm -f "${socket}"
+../build/bin/ti4cartographer --serve "${socket}" --players 6 --layout large --threads 2 > ../build/serve_log.txt &
+pid=$!
+attempts=0
+while [ ! -S "${socket}" ] && [ "${attempts}" -lt 100 ]; do
+  sleep 0.1
+  attempts=$((attempts + 1))
+done
+python3 - "${socket}" > ../build/serve_responses.txt <<'PYTHON'
+import socket
+import sys
+client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+client.connect(sys.argv[1])
+client.sendall(b"--players 6 --search annealing --seed 42\n--players 9\n")
+client.sendall(b"--seed " + b"1" * 10000 + b"\n--players 9\n")
+data = b""
+while data.count(b"\n") < 4:
+    chunk = client.recv(4096)
+    if not chunk:
+        break
+    data += chunk
+client.close()
+sys.stdout.write(data.decode())
+PYTHON
+kill -TERM "${pid}"
+wait "${pid}"
+test ! -e "${socket}"
+expected="$(../build/bin/ti4cartographer --players 6 --layout large --search annealing --seed 42 --quiet)"
+test "$(sed -n 1p ../build/serve_responses.txt)" = "${expected}"
+sed -n 2p ../build/serve_responses.txt | grep -q "^error: "
+sed -n 3p ../build/serve_responses.txt | grep -q "^error: The request is longer"
+sed -n 4p ../build/serve_responses.txt | grep -q "^error: The number of players"
@@ -0,0 +1,4 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+../build/bin/ti4cartographer --players 6 --layout regular --search annealing --seed 1 --stats --quiet | tail -n 1 | grep -q '^{"attempts":\[{"board":1,"attempt":1,"counters":{'
@@ -0,0 +1,11 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+# The replicas run concurrently, so the board itself is not reproducible.
+output="$(../build/bin/ti4cartographer --players 8 --layout large --aggression moderate --search tempering --threads 2 --seed 1)"
+target="$(printf '%s\n' "${output}" | sed -n 's/.*target score imbalance: \([0-9.]*\) %$/\1/p' | tail -n 1)"
+imbalance="$(printf '%s\n' "${output}" | sed -n 's/^Score imbalance: \([0-9.]*\) %$/\1/p')"
+test -n "${imbalance}"
+test -n "${target}"
+awk -v imbalance="${imbalance}" -v target="${target}" 'BEGIN { exit !(imbalance <= target) }'
+test "$(printf '%s\n' "${output}" | grep -c "^Tabletop Simulator string: ")" -eq 1
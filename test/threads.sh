@@ -0,0 +1,12 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+# The workers stop once one of them meets the target score imbalance of the
+# current attempt.
+output="$(../build/bin/ti4cartographer --players 6 --layout regular --aggression moderate --threads 4 --seed 1)"
+target="$(printf '%s\n' "${output}" | sed -n 's/.*target score imbalance: \([0-9.]*\) %$/\1/p' | tail -n 1)"
+imbalance="$(printf '%s\n' "${output}" | sed -n 's/^Score imbalance: \([0-9.]*\) %$/\1/p')"
+test -n "${imbalance}"
+test -n "${target}"
+awk -v imbalance="${imbalance}" -v target="${target}" 'BEGIN { exit !(imbalance <= target) }'
+test "$(printf '%s\n' "${output}" | grep -c "^Tabletop Simulator string: ")" -eq 1
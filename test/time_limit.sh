@@ -0,0 +1,20 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+test "$(../build/bin/ti4cartographer --players 8 --layout large --seed 1 --time-limit-ms 200 --quiet | wc -l)" -eq 1
+test "$(../build/bin/ti4cartographer --players 4 --seed 1 --time-limit-ms 18446744073709551615 --quiet)" = "$(../build/bin/ti4cartographer --players 4 --seed 1 --quiet)"
+# The exact search on a large layout runs far longer than this test, so only
+# the signal can stop it. It is signaled once it has found a first board.
+output="$(mktemp)"
+trap 'rm -f "${output}"' EXIT
+../build/bin/ti4cartographer --players 4 --layout large --search exact --seed 1 > "${output}" &
+pid=$!
+attempts=0
+while ! grep -q "^Iteration" "${output}" && [ "${attempts}" -lt 300 ]; do
+  sleep 0.1
+  attempts=$((attempts + 1))
+done
+kill -TERM "${pid}"
+wait "${pid}"
+grep -q "a stop was requested" "${output}"
+test "$(grep -c "^Tabletop Simulator string: " "${output}")" -eq 1
@@ -0,0 +1,7 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+test "$(../build/bin/ti4cartographer --players 6 --layout regular --search annealing --count 2 --top 3 --min-distance 8 --quiet | sort -u | wc -l)" -eq 6
+if ../build/bin/ti4cartographer --players 3 --layout small --seed 1 --top 2 --min-distance 16 --quiet > /dev/null 2>&1; then
+  exit 1
+fi
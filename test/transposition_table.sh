@@ -0,0 +1,4 @@
+#!/bin/sh
+set -e
+cd "${0%/*}"
+../build/bin/ti4cartographer --players 3 --layout small --search random --seed 1 --stats --quiet | tail -n 1 | grep -q '"transposition_table":{"probes":[1-9][0-9]*,"hits":[1-9][0-9]*,'